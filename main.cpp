@@ -6,16 +6,229 @@
 #include <fstream>
 #include <algorithm>
 #include <map>
+#include <limits>
+#include <unordered_set>
+#include <optional>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <shared_mutex>
+#include <memory>
+#include <string_view>
+#include <new>
+#include <type_traits>
+#include <sstream>
+#include <cmath>
+#include <bit>
+#include <numeric>
+#include <charconv>
+#if defined(__AVX2__) || defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 #ifdef _WIN32
 #include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/// @brief 128-битное произведение двух 64-битных чисел.
+/// @param a  Первый множитель.
+/// @param b  Второй множитель.
+/// @param lo Младшие 64 бита результата.
+/// @param hi Старшие 64 бита результата.
+inline void mul128(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    lo = static_cast<uint64_t>(r);
+    hi = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    lo = _umul128(a, b, &hi);
+#else
+    const uint64_t aL = a & 0xFFFFFFFFu, aH = a >> 32, bL = b & 0xFFFFFFFFu, bH = b >> 32;
+    const uint64_t ll = aL * bL, lh = aL * bH, hl = aH * bL, hh = aH * bH;
+    const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    lo = (mid << 32) | (ll & 0xFFFFFFFFu);
+    hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
 #endif
+}
+
+/// @brief Полиномиальный роллинг-хеш (по байту за шаг, основание 131).
+/// @param bytes Хешируемые байты.
+/// @return 64-битный хеш.
+inline uint64_t polynomialHashBytes(std::string_view bytes) {
+    uint64_t h = 0;
+    for (unsigned char c : bytes) {
+        h = h * 131 + c;
+    }
+    return h;
+}
+
+/// @brief Хеш FNV-1a (по байту за шаг).
+/// @param bytes Хешируемые байты.
+/// @return 64-битный хеш.
+inline uint64_t fnv1aHashBytes(std::string_view bytes) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (unsigned char c : bytes) {
+        h = (h ^ c) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+/// @brief Хеш в стиле wyhash: читает по 4/8 байт за шаг и перемешивает 128-битным умножением.
+/// @param bytes Хешируемые байты.
+/// @param seed  Начальное значение.
+/// @return 64-битный хеш.
+inline uint64_t wyHashBytes(std::string_view bytes, uint64_t seed = 0) {
+    constexpr uint64_t s0 = 0xa0761d6478bd642full, s1 = 0xe7037ed1a0b428dbull;
+    constexpr uint64_t s2 = 0x8ebc6af09c88c6e3ull, s3 = 0x589965cc75374cc3ull;
+    auto mix = [](uint64_t a, uint64_t b) {
+        uint64_t lo, hi;
+        mul128(a, b, lo, hi);
+        return lo ^ hi;
+    };
+    auto read8 = [](const unsigned char* p) { uint64_t v; std::memcpy(&v, p, 8); return v; };
+    auto read4 = [](const unsigned char* p) { uint32_t v; std::memcpy(&v, p, 4); return static_cast<uint64_t>(v); };
+
+    const auto* p = reinterpret_cast<const unsigned char*>(bytes.data());
+    const size_t len = bytes.size();
+    seed ^= mix(seed ^ s0, s1);
+    uint64_t a = 0, b = 0;
+    if (len <= 16) {
+        if (len >= 4) {
+            const size_t shift = (len >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + shift);
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - shift);
+        } else if (len > 0) {
+            a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mix(read8(p) ^ s1, read8(p + 8) ^ seed);
+                see1 = mix(read8(p + 16) ^ s2, read8(p + 24) ^ see1);
+                see2 = mix(read8(p + 32) ^ s3, read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mix(read8(p) ^ s1, read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+    uint64_t lo, hi;
+    mul128(a ^ s1, b ^ seed, lo, hi);
+    return mix(lo ^ s0 ^ len, hi ^ s1);
+}
+
+/// @brief Строковый ключ с заранее вычисленным хешем.
+///
+/// Хеш считается один раз при создании ключа. Сравнение на равенство сначала
+/// сравнивает хеши и длины и только при их совпадении — байты строки (memcmp),
+/// поэтому несовпадающие имена почти всегда отбрасываются за одно сравнение
+/// 64-битных чисел. Упорядочивание — обычное лексикографическое.
+class NameKey {
+public:
+    NameKey() : hashValue(hashBytes({})) {}
+
+    /// @brief Создаёт ключ из строки.
+    /// @param s Строка-ключ.
+    NameKey(std::string s) : text(std::move(s)), hashValue(hashBytes(text)) {}
+
+    /// @brief Создаёт ключ из C-строки.
+    /// @param s Строка-ключ.
+    NameKey(const char* s) : NameKey(std::string(s)) {}
+
+    /// @brief Возвращает строку ключа.
+    const std::string& str() const { return text; }
+    operator const std::string&() const { return text; }
+
+    /// @brief Возвращает заранее вычисленный 64-битный хеш.
+    uint64_t hash() const { return hashValue; }
+
+    /// @brief Возвращает длину ключа в байтах.
+    size_t size() const { return text.size(); }
+
+    /// @brief Трёхстороннее сравнение (лексикографическое) с быстрым путём для равных ключей.
+    /// @param other Другой ключ.
+    /// @return Отрицательное, ноль или положительное число.
+    int compare(const NameKey& other) const {
+        if (*this == other) return 0;
+        return text.compare(other.text);
+    }
+
+    friend bool operator==(const NameKey& a, const NameKey& b) {
+        return a.hashValue == b.hashValue && a.text.size() == b.text.size() &&
+               std::memcmp(a.text.data(), b.text.data(), a.text.size()) == 0;
+    }
+
+    friend bool operator<(const NameKey& a, const NameKey& b) { return a.text < b.text; }
+
+    friend std::ostream& operator<<(std::ostream& os, const NameKey& k) { return os << k.text; }
+
+    /// @brief Хеш-функция, которой вычисляется hash().
+    static uint64_t hashBytes(std::string_view bytes) {
+        return wyHashBytes(bytes);
+    }
+
+private:
+    std::string text;   ///< Строка ключа.
+    uint64_t hashValue; ///< Хеш строки.
+};
+
+/// @brief Политика хеширования: полиномиальный роллинг-хеш (исходный вариант HashTable).
+struct PolynomialHash {
+    static constexpr const char* name = "Polynomial"; ///< Имя политики для отчётов.
+    /// @brief Хеш ключа.
+    static uint64_t hash(const NameKey& key) { return polynomialHashBytes(key.str()); }
+};
+
+/// @brief Политика хеширования: FNV-1a.
+struct Fnv1aHash {
+    static constexpr const char* name = "FNV-1a"; ///< Имя политики для отчётов.
+    /// @brief Хеш ключа.
+    static uint64_t hash(const NameKey& key) { return fnv1aHashBytes(key.str()); }
+};
+
+/// @brief Политика хеширования: wyhash-подобный хеш по словам.
+struct WyHash {
+    static constexpr const char* name = "WyHash"; ///< Имя политики для отчётов.
+    /// @brief Хеш ключа.
+    static uint64_t hash(const NameKey& key) { return wyHashBytes(key.str()); }
+};
+
+/// @brief Политика хеширования: хеш, уже сохранённый в NameKey (WyHash без пересчёта).
+struct PrecomputedHash {
+    static constexpr const char* name = "Precomputed"; ///< Имя политики для отчётов.
+    /// @brief Хеш ключа.
+    static uint64_t hash(const NameKey& key) { return key.hash(); }
+};
 
 /// @brief Структура данных, в которой осуществляется поиск.
 ///
 /// Содержит идентификатор, строковое имя (ключ для поиска) и некоторое значение.
 struct Object {
     size_t    id;    ///< Уникальный идентификатор объекта.
-    std::string name;///< Имя объекта, по которому производится поиск.
+    NameKey   name;  ///< Имя объекта, по которому производится поиск (с хешем).
     double    value; ///< Некоторое числовое значение, ассоциированное с объектом.
 
     /// @brief Конструктор для инициализации всех полей.
@@ -24,39 +237,114 @@ struct Object {
     /// @param value_ Значение.
     Object(size_t id_, std::string name_, double value_)
             : id(id_), name(std::move(name_)), value(value_) {}
+
+    /// @brief Пустой объект (id 0, пустое имя) — для заполнения заранее выделенного массива.
+    Object() : id(0), value(0) {}
 };
 
-/// @brief Глобальный генератор случайных чисел для всего кода.
+/// @brief Глобальный генератор случайных чисел для всего кода (main засевает его --seed).
 static std::mt19937_64 rng{ std::random_device{}() };
 
+/// @brief Шаг SplitMix64: перемешивает 64-битное число.
+///
+/// Используется для получения независимых зёрен потоков из одного зерна.
+/// @param x Входное значение.
+/// @return Перемешанное значение.
+inline uint64_t splitMix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/// @brief Генератор xoshiro256** — быстрый 64-битный генератор с состоянием 32 байта.
+///
+/// Удовлетворяет требованиям UniformRandomBitGenerator. Состояние заполняется
+/// последовательными значениями splitMix64 от зерна.
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    /// @brief Засевает генератор.
+    /// @param seed Зерно.
+    explicit Xoshiro256(uint64_t seed) {
+        for (auto& word : state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            word = splitMix64(seed);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    /// @brief Возвращает следующее 64-битное число.
+    result_type operator()() {
+        const uint64_t result = std::rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = std::rotl(state[3], 45);
+        return result;
+    }
+
+private:
+    uint64_t state[4]; ///< Состояние генератора.
+};
+
+/// @brief Равномерное целое из [0, range) без деления на каждый вызов (метод Лемира).
+///
+/// Порог отбраковки, устраняющий смещение, вычисляется один раз в конструкторе;
+/// сам выбор — одно 128-битное умножение, повтор нужен с вероятностью < range / 2^64.
+class BoundedDistribution {
+public:
+    /// @param range Число значений (не меньше 1).
+    explicit BoundedDistribution(uint64_t range)
+            : range(std::max<uint64_t>(range, 1)), threshold((0 - this->range) % this->range) {}
+
+    /// @brief Возвращает случайное число из [0, range).
+    template <class Rng>
+    uint64_t operator()(Rng& gen) const {
+        uint64_t lo, hi;
+        do {
+            mul128(gen(), range, lo, hi);
+        } while (lo < threshold);
+        return hi;
+    }
+
+private:
+    uint64_t range;     ///< Число значений.
+    uint64_t threshold; ///< 2^64 mod range: младшие части ниже порога отбрасываются.
+};
+
+/// @brief Формирует имя "Name<number>" без временных строк.
+///
+/// Цифры пишутся std::to_chars в буфер на стеке; имя до 15 символов помещается
+/// во встроенный буфер std::string (SSO), и выделения памяти нет.
+/// @param number Номер имени.
+/// @return Строка вида "Name<number>".
+inline std::string formatName(uint64_t number) {
+    char buf[4 + 20] = {'N', 'a', 'm', 'e'};
+    char* end = std::to_chars(buf + 4, buf + sizeof(buf), number).ptr;
+    return std::string(buf, end);
+}
+
 /// @brief Генерирует случайную строку имени в формате "NameX".
 /// @param nameCount Количество различных имен (диапазон X: 0..nameCount-1).
+/// @param gen       Генератор случайных чисел.
 /// @return Строка вида "Name<number>".
-std::string generateRandomName(int nameCount) {
-    std::uniform_int_distribution<int> dist(0, nameCount - 1);
-    return "Name" + std::to_string(dist(rng));
+template <class Rng>
+std::string generateRandomName(int nameCount, Rng& gen) {
+    return formatName(BoundedDistribution(static_cast<uint64_t>(nameCount))(gen));
 }
 
-/// @brief Генерирует вектор объектов заданного размера с случайными данными.
-///
-/// Имена объектов выбираются случайно из ограниченного набора для обеспечения дубликатов.
-/// @param size Количество элементов, которое необходимо сгенерировать.
-/// @return Вектор сгенерированных объектов.
-std::vector<Object> generateData(size_t size) {
-    std::vector<Object> data;
-    data.reserve(size);
-    // const int nameCount = 1000;
-    size_t nameCount = std::max<size_t>(size / 5, 1);
-    std::uniform_real_distribution<double> valDist(0.0, 100.0);
-
-    for (size_t i = 0; i < size; ++i) {
-        data.emplace_back(
-                i + 1,
-                generateRandomName(static_cast<int>(nameCount)),
-                valDist(rng)
-        );
-    }
-    return data;
+/// @brief Генерирует случайную строку имени глобальным генератором rng.
+/// @param nameCount Количество различных имен (диапазон X: 0..nameCount-1).
+/// @return Строка вида "Name<number>".
+std::string generateRandomName(int nameCount) {
+    return generateRandomName(nameCount, rng);
 }
 
 /// @brief Линейный поиск всех объектов с заданным именем в массиве.
@@ -65,7 +353,7 @@ std::vector<Object> generateData(size_t size) {
 /// @param data Вектор объектов, в котором выполняется поиск.
 /// @param key  Искомое имя (ключ поиска).
 /// @return Вектор всех объектов, имя которых равно key.
-std::vector<Object> linearSearch(const std::vector<Object>& data, const std::string& key) {
+std::vector<Object> linearSearch(const std::vector<Object>& data, const NameKey& key) {
     std::vector<Object> result;
     for (const auto& obj : data) {
         if (obj.name == key) {
@@ -75,229 +363,1632 @@ std::vector<Object> linearSearch(const std::vector<Object>& data, const std::str
     return result;
 }
 
-/// @brief Класс для реализации невыровненного бинарного дерева поиска (BST) по ключу name.
+/// @brief Линейный поиск без копирования результатов.
 ///
-/// Поддерживает хранение нескольких объектов с одинаковым ключом в одном узле.
-class BinarySearchTree {
+/// Вызывает visit для каждого объекта с заданным именем, не выделяя памяти.
+/// @param data  Вектор объектов, в котором выполняется поиск.
+/// @param key   Искомое имя (ключ поиска).
+/// @param visit Функция вида void(const Object&).
+/// @return Число найденных объектов.
+template <class Visitor>
+size_t linearSearchEach(const std::vector<Object>& data, const NameKey& key, Visitor&& visit) {
+    size_t found = 0;
+    for (const auto& obj : data) {
+        if (obj.name == key) {
+            visit(obj);
+            ++found;
+        }
+    }
+    return found;
+}
+
+/// @brief Колоночное (struct-of-arrays) хранилище объектов.
+///
+/// Каждое поле лежит в своём массиве: имена — подряд в общем пуле символов с
+/// массивом смещений, рядом — заранее вычисленные хеши имён (как в NameKey),
+/// отдельно id и value. Скан по имени читает только хеши (8 байт на строку)
+/// и байты совпавших имён, не протаскивая через кэш id, value и заголовки строк.
+/// Для подтверждения кандидатов векторного скана (linearSearchSimd) хранятся ещё
+/// столбец длин имён и столбец первых kPrefixBytes байтов имён, дополненных нулями.
+/// Строки адресуются номерами (row) — теми же, что у исходного массива объектов.
+class ObjectTable {
 public:
-    /// @brief Внутренняя структура узла BST.
-    struct Node {
-        std::string         key;    ///< Ключевое поле (name).
-        std::vector<Object> values; ///< Все объекты с данным ключом.
-        Node*               left{nullptr};  ///< Левый потомок.
-        Node*               right{nullptr}; ///< Правый потомок.
+    static constexpr size_t kPrefixBytes = 16; ///< Байтов имени в столбце префиксов.
 
-        /// @brief Конструктор узла.
-        /// @param name Ключ.
-        /// @param obj  Объект, который добавляется в values.
-        Node(const std::string& name, const Object& obj)
-                : key(name), values{obj} {}
+    /// @brief Первые kPrefixBytes байтов имени, дополненные нулями (одна строка SSE-регистра).
+    struct alignas(16) NamePrefix {
+        char bytes[kPrefixBytes];
     };
 
-    BinarySearchTree() = default;
-    ~BinarySearchTree() { clear(root); }
+    /// @brief Строит префикс имени.
+    static NamePrefix makePrefix(std::string_view name) {
+        NamePrefix p{};
+        std::memcpy(p.bytes, name.data(), std::min(name.size(), kPrefixBytes));
+        return p;
+    }
 
-    /// @brief Вставляет объект в дерево поиска по его name.
-    ///
-    /// Если ключ уже есть — добавляет объект в вектор существующего узла.
-    /// @param obj Объект для вставки.
-    void insert(const Object& obj) {
-        if (!root) {
-            root = new Node(obj.name, obj);
-            return;
-        }
-        Node* cur = root;
-        while (true) {
-            if (obj.name == cur->key) {
-                cur->values.push_back(obj);
-                return;
-            }
-            if (obj.name < cur->key) {
-                if (!cur->left) {
-                    cur->left = new Node(obj.name, obj);
-                    return;
-                }
-                cur = cur->left;
-            } else {
-                if (!cur->right) {
-                    cur->right = new Node(obj.name, obj);
-                    return;
-                }
-                cur = cur->right;
-            }
-        }
+    /// @brief Длина имени в столбце длин (длины от 255 хранятся как 255).
+    static uint8_t clampLength(size_t length) {
+        return static_cast<uint8_t>(std::min<size_t>(length, 255));
     }
 
-    /// @brief Осуществляет поиск всех объектов с заданным именем.
-    /// @param key Искомый ключ (name).
-    /// @return Вектор найденных объектов (может быть пустым).
-    std::vector<Object> search(const std::string& key) const {
-        Node* cur = root;
-        while (cur) {
-            if (key == cur->key) {
-                return cur->values;
-            }
-            if (key < cur->key) {
-                cur = cur->left;
-            } else {
-                cur = cur->right;
-            }
-        }
-        return {};
+    ObjectTable() { offsets.push_back(0); }
+
+    /// @brief Строит таблицу по массиву объектов (номера строк совпадают с индексами data).
+    /// @param data Объекты.
+    explicit ObjectTable(const std::vector<Object>& data) : ObjectTable() {
+        size_t bytes = 0;
+        for (const auto& obj : data) bytes += obj.name.size();
+        chars.reserve(bytes);
+        offsets.reserve(data.size() + 1);
+        hashes.reserve(data.size());
+        lengths.reserve(data.size());
+        prefixes.reserve(data.size());
+        ids.reserve(data.size());
+        values.reserve(data.size());
+        for (const auto& obj : data) push_back(obj);
     }
 
-private:
-    Node* root{nullptr}; ///< Корневой узел.
+    /// @brief Добавляет объект в конец таблицы.
+    /// @param obj Объект.
+    void push_back(const Object& obj) {
+        const std::string& name = obj.name.str();
+        chars.insert(chars.end(), name.begin(), name.end());
+        offsets.push_back(static_cast<uint32_t>(chars.size()));
+        hashes.push_back(obj.name.hash());
+        lengths.push_back(clampLength(name.size()));
+        prefixes.push_back(makePrefix(name));
+        ids.push_back(obj.id);
+        values.push_back(obj.value);
+    }
 
-    /// @brief Рекурсивно освобождает память, занимаемую поддеревом.
-    /// @param n Корень поддерева.
-    void clear(Node* n) {
-        if (!n) return;
-        clear(n->left);
-        clear(n->right);
-        delete n;
+    /// @brief Возвращает число строк.
+    size_t size() const { return ids.size(); }
+
+    /// @brief Имя строки row (представление в пуле символов).
+    std::string_view name(size_t row) const {
+        return {chars.data() + offsets[row], offsets[row + 1] - offsets[row]};
     }
-};
 
-/// @brief Класс красно-черного дерева (Red-Black Tree) для поиска по ключу name.
-///
-/// Гарантирует балансировку и поиск за O(log n).
-class RedBlackTree {
-public:
-    /// @brief Цвет узла.
-    enum Color { RED, BLACK };
+    /// @brief Хеш имени строки row.
+    uint64_t nameHash(size_t row) const { return hashes[row]; }
 
-    /// @brief Структура узла красно-черного дерева.
-    struct Node {
-        std::string         key;    ///< Ключ узла (name).
-        std::vector<Object> values; ///< Все объекты с данным ключом.
-        Color               color;  ///< Цвет узла.
-        Node*               left{nullptr};   ///< Левый потомок.
-        Node*               right{nullptr};  ///< Правый потомок.
-        Node*               parent{nullptr}; ///< Родитель.
+    /// @brief Начало столбца хешей имён.
+    const uint64_t* hashData() const { return hashes.data(); }
 
-        /// @brief Конструктор узла.
-        /// @param name Ключ.
-        /// @param obj  Объект для values.
-        /// @param c    Цвет (RED или BLACK).
-        /// @param p    Родительский узел.
-        Node(const std::string& name, const Object& obj, Color c, Node* p)
-                : key(name), values{obj}, color(c), parent(p) {}
-    };
+    /// @brief Начало столбца длин имён.
+    const uint8_t* lengthData() const { return lengths.data(); }
 
-    RedBlackTree() = default;
-    ~RedBlackTree() { clear(root); }
+    /// @brief Начало столбца префиксов имён.
+    const NamePrefix* prefixData() const { return prefixes.data(); }
 
-    /// @brief Вставляет объект в красно-черное дерево с балансировкой.
-    /// @param obj Объект для вставки.
-    void insert(const Object& obj) {
-        if (!root) {
-            root = new Node(obj.name, obj, BLACK, nullptr);
-            return;
-        }
-        Node* cur = root;
-        Node* parent = nullptr;
-        while (cur) {
-            parent = cur;
-            if (obj.name == cur->key) {
-                cur->values.push_back(obj);
-                return;
-            }
-            cur = (obj.name < cur->key ? cur->left : cur->right);
-        }
-        Node* node = new Node(obj.name, obj, RED, parent);
-        if (obj.name < parent->key) parent->left  = node;
-        else                         parent->right = node;
-        insertFix(node);
+    /// @brief id строки row.
+    size_t id(size_t row) const { return ids[row]; }
+
+    /// @brief value строки row.
+    double value(size_t row) const { return values[row]; }
+
+    /// @brief Собирает объект строки row.
+    Object row(size_t r) const { return Object(ids[r], std::string(name(r)), values[r]); }
+
+    /// @brief Проверяет, что имя строки row равно key: хеш, затем длина и байты.
+    bool nameEquals(size_t row, const NameKey& key) const {
+        return hashes[row] == key.hash() && name(row) == std::string_view(key.str());
     }
 
-    /// @brief Осуществляет поиск всех объектов с заданным именем.
-    /// @param key Искомое имя.
-    /// @return Вектор найденных объектов.
-    std::vector<Object> search(const std::string& key) const {
-        Node* cur = root;
-        while (cur) {
-            if (key == cur->key) return cur->values;
-            if (key < cur->key)  cur = cur->left;
-            else                 cur = cur->right;
-        }
-        return {};
+    /// @brief Возвращает объём памяти столбцов в байтах.
+    size_t memoryBytes() const {
+        return chars.size() + offsets.size() * sizeof(uint32_t) + hashes.size() * sizeof(uint64_t) +
+               lengths.size() + prefixes.size() * sizeof(NamePrefix) +
+               ids.size() * sizeof(size_t) + values.size() * sizeof(double);
     }
 
 private:
-    Node* root{nullptr}; ///< Корень дерева.
+    std::vector<char>     chars;   ///< Символы всех имён подряд.
+    std::vector<uint32_t> offsets; ///< Начало имени строки i — offsets[i], конец — offsets[i + 1].
+    std::vector<uint64_t> hashes;  ///< Хеши имён (NameKey::hash).
+    std::vector<uint8_t>  lengths; ///< Длины имён (clampLength).
+    std::vector<NamePrefix> prefixes; ///< Префиксы имён (makePrefix).
+    std::vector<size_t>   ids;     ///< Столбец id.
+    std::vector<double>   values;  ///< Столбец value.
+};
 
-    /// @brief Восстанавливает баланс после вставки узла.
-    /// @param n Вставленный узел.
-    void insertFix(Node* n) {
-        while (n != root && n->parent->color == RED) {
-            Node* p = n->parent;
-            Node* g = p->parent;
-            if (p == g->left) {
-                Node* u = g->right;
-                if (u && u->color == RED) {
-                    // Случай 1: перекраска
-                    p->color = BLACK;
-                    u->color = BLACK;
-                    g->color = RED;
-                    n = g;
-                } else {
-                    if (n == p->right) {
-                        // Случай 2: левый поворот вокруг p
-                        n = p;
-                        rotateLeft(n);
-                        p = n->parent;
-                        g = p->parent;
-                    }
-                    // Случай 3: правый поворот вокруг g
-                    p->color = BLACK;
-                    g->color = RED;
-                    rotateRight(g);
-                }
-            } else {
-                // Симметричные случаи, когда p — правый ребёнок g
-                Node* u = g->left;
-                if (u && u->color == RED) {
-                    p->color = BLACK;
-                    u->color = BLACK;
-                    g->color = RED;
-                    n = g;
-                } else {
-                    if (n == p->left) {
-                        n = p;
-                        rotateRight(n);
-                        p = n->parent;
-                        g = p->parent;
-                    }
-                    p->color = BLACK;
-                    g->color = RED;
-                    rotateLeft(g);
-                }
-            }
+/// @brief Линейный поиск по колоночной таблице: вызывает visit(row) для строк с именем key.
+///
+/// Сканируется только столбец хешей; длина и байты имени проверяются лишь при
+/// совпадении хеша.
+/// @param table Таблица объектов.
+/// @param key   Искомое имя.
+/// @param visit Функция вида void(size_t row).
+/// @return Число найденных строк.
+template <class Visitor>
+size_t linearSearchRows(const ObjectTable& table, const NameKey& key, Visitor&& visit) {
+    size_t found = 0;
+    for (size_t row = 0; row < table.size(); ++row) {
+        if (table.nameHash(row) == key.hash() && table.nameEquals(row, key)) {
+            visit(row);
+            ++found;
         }
-        root->color = BLACK;  // корень всегда черный
     }
+    return found;
+}
 
-    /// @brief Левый поворот поддерева вокруг узла x.
-    /// @param x Узел, вокруг которого крутят влево.
-    void rotateLeft(Node* x) {
-        Node* y = x->right;
-        x->right = y->left;
-        if (y->left) y->left->parent = x;
-        transplant(x, y);
-        y->left   = x;
-        x->parent = y;
+/// @brief Число строк, которые ядро векторного скана проверяет за один вызов.
+constexpr size_t kScanBlock = 32;
+
+/// @brief Ядро векторного скана: сравнивает хеши kScanBlock строк подряд с хешем ключа.
+///
+/// Возвращает маску строк блока, хеш имени которых равен hash. Это фильтр по
+/// столбцу хешей (8 байт на строку); кандидатов подтверждает вызывающий по длине,
+/// 16-байтовому префиксу и, для длинных имён, остатку имени.
+struct NameScanKernel {
+    const char* name; ///< Имя ядра для отчётов.
+    uint32_t (*block)(const uint64_t* hashes, uint64_t hash);
+};
+
+/// @brief Скалярное ядро скана (переносимый вариант).
+inline uint32_t scanBlockScalar(const uint64_t* hashes, uint64_t hash) {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kScanBlock; ++i) {
+        mask |= static_cast<uint32_t>(hashes[i] == hash) << i;
     }
+    return mask;
+}
 
-    /// @brief Правый поворот поддерева вокруг узла x.
-    /// @param x Узел, вокруг которого крутят вправо.
-    void rotateRight(Node* x) {
-        Node* y = x->left;
-        x->left = y->right;
-        if (y->right) y->right->parent = x;
-        transplant(x, y);
-        y->right  = x;
-        x->parent = y;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+/// @brief Ядро скана на SSE2: два хеша на сравнение.
+///
+/// В SSE2 нет 64-битного сравнения, поэтому сравниваются 32-битные половины, и
+/// строка совпадает, когда совпали обе её половины.
+inline uint32_t scanBlockSse2(const uint64_t* hashes, uint64_t hash) {
+    const __m128i k = _mm_set1_epi64x(static_cast<long long>(hash));
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < kScanBlock; i += 2) {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hashes + i));
+        const unsigned eq = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(h, k))));
+        mask |= static_cast<uint32_t>((eq & 0x3u) == 0x3u) << i;
+        mask |= static_cast<uint32_t>((eq & 0xCu) == 0xCu) << (i + 1);
+    }
+    return mask;
+}
+#endif
+
+#if defined(__AVX2__) || ((defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))) || \
+    (defined(_MSC_VER) && defined(_M_X64))
+#define NAME_SCAN_HAS_AVX2 1
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__AVX2__)
+#define NAME_SCAN_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define NAME_SCAN_AVX2_TARGET
+#endif
+
+/// @brief Ядро скана на AVX2: четыре хеша на сравнение.
+///
+/// Собирается с атрибутом target("avx2") независимо от флагов компиляции;
+/// вызывается только если процессор поддерживает AVX2 (см. nameScanKernel).
+NAME_SCAN_AVX2_TARGET
+inline uint32_t scanBlockAvx2(const uint64_t* hashes, uint64_t hash) {
+    const __m256i k = _mm256_set1_epi64x(static_cast<long long>(hash));
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < kScanBlock; i += 4) {
+        const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hashes + i));
+        mask |= static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(h, k)))) << i;
+    }
+    return mask;
+}
+#endif
+
+/// @brief Проверяет (CPUID) поддержку AVX2 процессором и операционной системой.
+inline bool cpuHasAvx2() {
+#if defined(__AVX2__)
+    return true;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && defined(_M_X64)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+/// @brief Ядро векторного скана, выбранное по возможностям процессора (один раз за запуск).
+inline const NameScanKernel& nameScanKernel() {
+    static const NameScanKernel kernel = [] {
+#if defined(NAME_SCAN_HAS_AVX2)
+        if (cpuHasAvx2()) return NameScanKernel{"avx2", scanBlockAvx2};
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        return NameScanKernel{"sse2", scanBlockSse2};
+#else
+        return NameScanKernel{"scalar", scanBlockScalar};
+#endif
+    }();
+    return kernel;
+}
+
+/// @brief Векторный линейный поиск по колоночной таблице: вызывает visit(row) для строк с именем key.
+///
+/// Ядро kernel отбирает кандидатов по столбцу хешей блоками по kScanBlock строк;
+/// кандидат подтверждается длиной и 16-байтовым префиксом, а имена длиннее
+/// префикса — ещё и сравнением остатка. Хвост таблицы короче блока проверяется
+/// скалярно.
+/// @param table  Таблица объектов.
+/// @param key    Искомое имя.
+/// @param visit  Функция вида void(size_t row).
+/// @param kernel Ядро скана (по умолчанию — выбранное по CPUID).
+/// @return Число найденных строк.
+template <class Visitor>
+size_t linearSearchSimd(const ObjectTable& table, const NameKey& key, Visitor&& visit,
+                        const NameScanKernel& kernel = nameScanKernel()) {
+    const ObjectTable::NamePrefix keyPrefix = ObjectTable::makePrefix(key.str());
+    const uint8_t keyLength = ObjectTable::clampLength(key.size());
+    const bool checkTail = key.size() > ObjectTable::kPrefixBytes;
+    const uint64_t keyHash = key.hash();
+    const uint64_t* hashes = table.hashData();
+    const uint8_t* lengths = table.lengthData();
+    const ObjectTable::NamePrefix* prefixes = table.prefixData();
+    const size_t n = table.size();
+
+    size_t found = 0;
+    auto confirm = [&](size_t row) {
+        if (lengths[row] != keyLength ||
+            std::memcmp(prefixes[row].bytes, keyPrefix.bytes, ObjectTable::kPrefixBytes) != 0) return;
+        if (checkTail && table.name(row) != std::string_view(key.str())) return;
+        visit(row);
+        ++found;
+    };
+    size_t row = 0;
+    for (; row + kScanBlock <= n; row += kScanBlock) {
+        for (uint32_t m = kernel.block(hashes + row, keyHash); m; m &= m - 1) {
+            confirm(row + static_cast<size_t>(std::countr_zero(m)));
+        }
+    }
+    for (; row < n; ++row) {
+        if (hashes[row] == keyHash) confirm(row);
+    }
+    return found;
+}
+
+/// @brief Простой пул потоков для параллельной обработки независимых частей данных.
+///
+/// Вызывающий поток тоже участвует в работе, поэтому пул размера 1 не создаёт
+/// дополнительных потоков. Задачи раздаются через атомарный счётчик.
+class ThreadPool {
+public:
+    /// @brief Создаёт пул.
+    /// @param threads Общее число потоков, включая вызывающий (не меньше 1).
+    explicit ThreadPool(size_t threads) {
+        threads = std::max<size_t>(threads, 1);
+        for (size_t i = 1; i < threads; ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    /// @brief Возвращает общее число потоков пула.
+    size_t size() const { return workers.size() + 1; }
+
+    /// @brief Выполняет fn(i) для всех i из [0, tasks) и ждёт завершения.
+    /// @param tasks Число задач.
+    /// @param fn    Функция вида void(size_t).
+    template <class F>
+    void run(size_t tasks, F&& fn) {
+        if (workers.empty() || tasks <= 1) {
+            for (size_t i = 0; i < tasks; ++i) fn(i);
+            return;
+        }
+        std::function<void(size_t)> task = std::forward<F>(fn);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &task;
+            total = tasks;
+            next.store(0);
+            busy = workers.size();
+            ++generation;
+        }
+        wake.notify_all();
+        drain();
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return busy == 0; });
+        job = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers;                   ///< Рабочие потоки.
+    std::mutex mutex;                                   ///< Защищает состояние задания.
+    std::condition_variable wake;                       ///< Сигнал о новом задании.
+    std::condition_variable done;                       ///< Сигнал о завершении задания.
+    const std::function<void(size_t)>* job{nullptr};    ///< Текущее задание.
+    std::atomic<size_t> next{0};                        ///< Следующая невыданная задача.
+    size_t total{0};                                    ///< Число задач в задании.
+    size_t busy{0};                                     ///< Рабочие, не завершившие задание.
+    size_t generation{0};                               ///< Номер текущего задания.
+    bool stopping{false};                               ///< Признак остановки пула.
+
+    /// @brief Выполняет задачи текущего задания, пока они не кончатся.
+    void drain() {
+        for (size_t i = next.fetch_add(1); i < total; i = next.fetch_add(1)) {
+            (*job)(i);
+        }
+    }
+
+    /// @brief Основной цикл рабочего потока.
+    void workerLoop() {
+        size_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            lock.unlock();
+            drain();
+            lock.lock();
+            if (--busy == 0) done.notify_one();
+        }
+    }
+};
+
+/// @brief Параллельный линейный поиск всех объектов с заданным именем.
+///
+/// Массив делится на pool.size() непрерывных частей, которые просматриваются
+/// одновременно; найденные объекты склеиваются в исходном порядке.
+/// @param data Вектор объектов, в котором выполняется поиск.
+/// @param key  Искомое имя (ключ поиска).
+/// @param pool Пул потоков.
+/// @return Вектор всех объектов, имя которых равно key (в порядке следования в data).
+std::vector<Object> parallelLinearSearch(const std::vector<Object>& data, const NameKey& key,
+                                         ThreadPool& pool) {
+    const size_t chunks = pool.size();
+    std::vector<std::vector<Object>> parts(chunks);
+    pool.run(chunks, [&](size_t c) {
+        const size_t begin = data.size() * c / chunks;
+        const size_t end   = data.size() * (c + 1) / chunks;
+        for (size_t i = begin; i < end; ++i) {
+            if (data[i].name == key) {
+                parts[c].push_back(data[i]);
+            }
+        }
+    });
+    std::vector<Object> result;
+    for (auto& part : parts) {
+        result.insert(result.end(), std::make_move_iterator(part.begin()),
+                      std::make_move_iterator(part.end()));
+    }
+    return result;
+}
+
+/// @brief Пространство имён набора данных: число различных имён и распределение их длины.
+///
+/// Имя с номером number — "Name<number>" (formatName), если длины не заданы.
+/// Иначе длина имени берётся детерминированно по номеру из [minLength, maxLength]
+/// (не короче естественной), и между "Name" и цифрами вставляется заполнитель
+/// "abc...z" нужной длины: длинные имена делят длинный общий префикс, как URL или
+/// пути. Цифры в конце однозначно задают номер, поэтому разные номера дают разные имена.
+struct KeySpace {
+    size_t cardinality = 0; ///< Различных имён (0 — size/5, как в исходном генераторе).
+    size_t minLength   = 0; ///< Минимальная длина имени.
+    size_t maxLength   = 0; ///< Максимальная длина имени (0 — имена "Name<number>" без заполнителя).
+
+    /// @brief Число различных имён для набора из size объектов.
+    uint64_t count(size_t size) const {
+        return cardinality ? cardinality : std::max<size_t>(size / 5, 1);
+    }
+
+    /// @brief Формирует имя с номером number.
+    std::string name(uint64_t number) const {
+        if (maxLength == 0) return formatName(number);
+        char digits[20];
+        const size_t digitCount = static_cast<size_t>(std::to_chars(digits, digits + sizeof(digits), number).ptr - digits);
+        const uint64_t spread = maxLength > minLength ? maxLength - minLength + 1 : 1;
+        const size_t length = std::max<size_t>(4 + digitCount, minLength + splitMix64(number) % spread);
+        std::string result(length, '\0');
+        std::memcpy(result.data(), "Name", 4);
+        for (size_t i = 4; i < length - digitCount; ++i) result[i] = static_cast<char>('a' + (i - 4) % 26);
+        std::memcpy(result.data() + length - digitCount, digits, digitCount);
+        return result;
+    }
+};
+
+/// @brief Генерирует вектор объектов заданного размера с случайными данными.
+///
+/// Имена объектов выбираются случайно из ограниченного набора для обеспечения
+/// дубликатов. Массив делится на блоки по kBlock объектов; у каждого блока свой
+/// генератор Xoshiro256, засеянный splitMix64(seed + номер блока). Блоки
+/// генерируются параллельно, и результат для данного seed побитно одинаков при
+/// любом числе потоков. Номер имени выбирается одной заранее построенной
+/// BoundedDistribution, имя форматируется formatName, value берётся из 53 старших
+/// бит случайного числа.
+/// @param size    Количество элементов, которое необходимо сгенерировать.
+/// @param seed    Зерно генерации.
+/// @param threads Число потоков.
+/// @param keys    Пространство имён (число различных имён и их длины).
+/// @return Вектор сгенерированных объектов.
+std::vector<Object> generateData(size_t size, uint64_t seed, size_t threads, const KeySpace& keys) {
+    constexpr size_t kBlock = 16384;
+    const size_t blocks = (size + kBlock - 1) / kBlock;
+    // Блоки пишут прямо в свои участки общего массива, без промежуточных векторов.
+    std::vector<Object> data(size);
+    ThreadPool pool(std::min(threads, std::max<size_t>(blocks, 1)));
+    const BoundedDistribution nameDist(keys.count(size));
+    pool.run(blocks, [&](size_t b) {
+        Xoshiro256 gen(splitMix64(seed + b));
+        const size_t begin = b * kBlock, end = std::min(size, begin + kBlock);
+        for (size_t i = begin; i < end; ++i) {
+            Object& obj = data[i];
+            obj.id = i + 1;
+            obj.value = static_cast<double>(gen() >> 11) * 0x1.0p-53 * 100.0;
+            obj.name = NameKey(keys.name(nameDist(gen)));
+        }
+    });
+    return data;
+}
+
+/// @brief Генерирует данные с size/5 различными именами вида "Name<number>".
+/// @param size    Количество элементов.
+/// @param seed    Зерно генерации.
+/// @param threads Число потоков.
+/// @return Вектор сгенерированных объектов.
+std::vector<Object> generateData(size_t size, uint64_t seed,
+                                 size_t threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1)) {
+    return generateData(size, seed, threads, KeySpace{});
+}
+
+/// @brief Генерирует данные с зерном из глобального генератора rng.
+/// @param size Количество элементов.
+/// @return Вектор сгенерированных объектов.
+std::vector<Object> generateData(size_t size) {
+    return generateData(size, rng());
+}
+
+/// @brief Распределение Ципфа на [0, n): ранг r выпадает с вероятностью ~ 1 / (r + 1)^theta.
+///
+/// Метод Грея и др. (как в YCSB): константы считаются один раз за O(n), выборка —
+/// за O(1) без таблиц.
+class ZipfDistribution {
+public:
+    /// @param n     Число рангов (не меньше 1).
+    /// @param theta Показатель перекоса, [0, 1): 0 — равномерно, 0.99 — сильный перекос.
+    ZipfDistribution(uint64_t n, double theta)
+            : n(std::max<uint64_t>(n, 1)), theta(std::clamp(theta, 0.0, 0.9999)) {
+        zetaN = zeta(this->n, this->theta);
+        const double zeta2 = zeta(2, this->theta);
+        alpha = 1.0 / (1.0 - this->theta);
+        eta = (1.0 - std::pow(2.0 / static_cast<double>(this->n), 1.0 - this->theta)) / (1.0 - zeta2 / zetaN);
+        secondRank = 1.0 + std::pow(0.5, this->theta);
+    }
+
+    /// @brief Возвращает ранг из [0, n).
+    template <class Rng>
+    uint64_t operator()(Rng& gen) const {
+        const double u = static_cast<double>(gen() >> 11) * 0x1.0p-53;
+        const double uz = u * zetaN;
+        if (uz < 1.0) return 0;
+        if (uz < secondRank) return std::min<uint64_t>(1, n - 1);
+        const double r = static_cast<double>(n) * std::pow(eta * u - eta + 1.0, alpha);
+        return std::min(static_cast<uint64_t>(r), n - 1);
+    }
+
+private:
+    /// @brief Обобщённое гармоническое число: сумма 1 / i^theta для i = 1..count.
+    static double zeta(uint64_t count, double theta) {
+        double sum = 0;
+        for (uint64_t i = 1; i <= count; ++i) sum += 1.0 / std::pow(static_cast<double>(i), theta);
+        return sum;
+    }
+
+    uint64_t n;        ///< Число рангов.
+    double theta;      ///< Показатель перекоса.
+    double zetaN;      ///< zeta(n, theta).
+    double alpha;      ///< 1 / (1 - theta).
+    double eta;        ///< Константа метода.
+    double secondRank; ///< Порог для ранга 1.
+};
+
+/// @brief Распределение популярности ключей поиска.
+enum class Popularity {
+    Uniform, ///< Все ключи равновероятны.
+    Zipf,    ///< Ципф с показателем zipfTheta.
+    Hotspot  ///< Доля hotAccess поисков приходится на долю hotKeys ключей.
+};
+
+/// @brief Имя распределения популярности для отчётов и командной строки.
+inline const char* popularityName(Popularity p) {
+    switch (p) {
+        case Popularity::Zipf:    return "zipf";
+        case Popularity::Hotspot: return "hotspot";
+        default:                  return "uniform";
+    }
+}
+
+/// @brief Параметры нагрузки: набор данных и поток ключей поиска.
+struct WorkloadSpec {
+    KeySpace   keys;                             ///< Число различных имён и их длины.
+    Popularity popularity = Popularity::Uniform; ///< Популярность ключей.
+    double     zipfTheta  = 0.99;                ///< Перекос Ципфа.
+    double     hotKeys    = 0.01;                ///< Доля «горячих» ключей (Hotspot).
+    double     hotAccess  = 0.9;                 ///< Доля поисков по горячим ключам (Hotspot).
+    double     missRatio  = 0.0;                 ///< Доля отсутствующих ключей.
+};
+
+/// @brief Генератор потока ключей поиска по набору данных.
+///
+/// Попадания выбираются среди различных имён, реально присутствующих в data,
+/// по рангу популярности; ранги назначаются именам в порядке первого появления в
+/// данных, то есть случайно относительно порядка имён, и популярные ключи
+/// разбросаны по всем индексам. Промахи — имена того же пространства KeySpace с
+/// номерами за его диапазоном: той же длины и формы, но заведомо отсутствующие.
+class Workload {
+public:
+    /// @param data Объекты; должны жить дольше генератора.
+    /// @param spec Параметры нагрузки (те же keys, что при генерации data).
+    Workload(const std::vector<Object>& data, const WorkloadSpec& spec)
+            : spec(spec), missBase(spec.keys.count(data.size())),
+              zipf(1, spec.zipfTheta), rankDist(1) {
+        std::unordered_set<std::string_view> seen;
+        seen.reserve(std::min<size_t>(data.size(), missBase) * 2);
+        for (const auto& obj : data) {
+            if (seen.insert(obj.name.str()).second) present.push_back(&obj.name);
+        }
+        const uint64_t n = std::max<size_t>(present.size(), 1);
+        if (spec.popularity == Popularity::Zipf) zipf = ZipfDistribution(n, spec.zipfTheta);
+        rankDist = BoundedDistribution(n);
+        hotCount = std::clamp<uint64_t>(static_cast<uint64_t>(std::llround(spec.hotKeys * static_cast<double>(n))), 1, n);
+    }
+
+    /// @brief Возвращает следующий ключ поиска.
+    template <class Rng>
+    NameKey next(Rng& gen) const {
+        const double u = static_cast<double>(gen() >> 11) * 0x1.0p-53;
+        if (present.empty() || u < spec.missRatio) return absentKey(BoundedDistribution(missBase)(gen));
+        return *present[rank(gen)];
+    }
+
+    /// @brief Возвращает count ключей поиска.
+    template <class Rng>
+    std::vector<NameKey> keys(size_t count, Rng& gen) const {
+        std::vector<NameKey> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) result.push_back(next(gen));
+        return result;
+    }
+
+    /// @brief Заведомо отсутствующий в данных ключ с номером i.
+    NameKey absentKey(uint64_t i) const { return NameKey(spec.keys.name(missBase + i)); }
+
+    /// @brief Число различных имён в данных.
+    size_t cardinality() const { return present.size(); }
+
+    /// @brief Средняя длина различных имён в данных.
+    double averageKeyLength() const {
+        size_t bytes = 0;
+        for (const NameKey* key : present) bytes += key->size();
+        return static_cast<double>(bytes) / static_cast<double>(std::max<size_t>(present.size(), 1));
+    }
+
+private:
+    /// @brief Ранг попадания по распределению популярности.
+    template <class Rng>
+    uint64_t rank(Rng& gen) const {
+        switch (spec.popularity) {
+            case Popularity::Zipf:
+                return zipf(gen);
+            case Popularity::Hotspot: {
+                const uint64_t n = present.size();
+                const double u = static_cast<double>(gen() >> 11) * 0x1.0p-53;
+                if (u < spec.hotAccess || hotCount == n) return BoundedDistribution(hotCount)(gen);
+                return hotCount + BoundedDistribution(n - hotCount)(gen);
+            }
+            default:
+                return rankDist(gen);
+        }
+    }
+
+    WorkloadSpec spec;                   ///< Параметры нагрузки.
+    std::vector<const NameKey*> present; ///< Различные имена данных в порядке первого появления.
+    uint64_t missBase;                   ///< Первый номер имени за диапазоном данных.
+    uint64_t hotCount = 1;               ///< Число горячих ключей.
+    ZipfDistribution zipf;               ///< Ранги Ципфа.
+    BoundedDistribution rankDist;        ///< Равномерные ранги.
+};
+
+/// @brief Арена узлов: выделяет объекты типа T блоками (slab) по SlabSize штук.
+///
+/// Узлы лежат в памяти подряд в порядке создания, создание узла — сдвиг указателя
+/// внутри текущего блока. destroy() уничтожает отдельный узел и кладёт его ячейку
+/// в список свободных (односвязный список внутри самих ячеек); create() сначала
+/// переиспользует свободные ячейки, так что при чередовании вставок и удалений
+/// арена не растёт. clear() уничтожает все живые узлы одним линейным проходом по
+/// блокам (без рекурсии и обхода указателей) и возвращает блоки системе. Для
+/// тривиально разрушаемых T проход не нужен и освобождение занимает O(число блоков).
+/// @tparam T        Тип узла.
+/// @tparam SlabSize Число узлов в одном блоке.
+template <class T, size_t SlabSize = 4096>
+class NodeArena {
+public:
+    NodeArena() = default;
+    ~NodeArena() { clear(); }
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    /// @brief Создаёт новый узел в арене.
+    /// @param args Аргументы конструктора T.
+    /// @return Указатель на созданный узел.
+    template <class... Args>
+    T* create(Args&&... args) {
+        if (freeList) {
+            FreeSlot* slot = freeList;
+            freeList = slot->next;
+            --freeCount;
+            return new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+        }
+        if (slabs.empty() || used == SlabSize) {
+            slabs.push_back(static_cast<T*>(
+                    ::operator new(sizeof(T) * SlabSize, std::align_val_t(alignof(T)))));
+            used = 0;
+        }
+        T* node = new (slabs.back() + used) T(std::forward<Args>(args)...);
+        ++used;
+        return node;
+    }
+
+    /// @brief Уничтожает узел и возвращает его ячейку в арену для повторного использования.
+    /// @param node Узел, созданный этой ареной.
+    void destroy(T* node) {
+        node->~T();
+        auto* slot = new (static_cast<void*>(node)) FreeSlot{freeList};
+        freeList = slot;
+        ++freeCount;
+    }
+
+    /// @brief Уничтожает все узлы и освобождает память арены.
+    void clear() {
+        // Свободные ячейки уже разрушены: собираем их адреса по возрастанию и
+        // пропускаем при линейном проходе по блокам.
+        std::vector<const void*> freed;
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            freed.reserve(freeCount);
+            for (FreeSlot* f = freeList; f; f = f->next) freed.push_back(f);
+            std::sort(freed.begin(), freed.end(), std::less<>());
+        }
+        for (size_t s = 0; s < slabs.size(); ++s) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                const size_t n = (s + 1 == slabs.size()) ? used : SlabSize;
+                auto skip = std::lower_bound(freed.begin(), freed.end(),
+                                             static_cast<const void*>(slabs[s]), std::less<>());
+                for (size_t i = 0; i < n; ++i) {
+                    if (skip != freed.end() && *skip == static_cast<const void*>(slabs[s] + i)) {
+                        ++skip;
+                        continue;
+                    }
+                    slabs[s][i].~T();
+                }
+            }
+            ::operator delete(slabs[s], std::align_val_t(alignof(T)));
+        }
+        slabs.clear();
+        used = 0;
+        freeList = nullptr;
+        freeCount = 0;
+    }
+
+    /// @brief Возвращает число живых узлов.
+    size_t size() const { return capacity() - freeCount; }
+
+    /// @brief Возвращает число ячеек во всех выделенных блоках, включая свободные.
+    size_t capacity() const {
+        return slabs.empty() ? 0 : (slabs.size() - 1) * SlabSize + used;
+    }
+
+private:
+    /// @brief Свободная ячейка: на месте уничтоженного узла хранится ссылка на следующую.
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+    static_assert(sizeof(T) >= sizeof(FreeSlot) && alignof(T) >= alignof(FreeSlot),
+                  "NodeArena: узел должен вмещать указатель списка свободных ячеек");
+
+    std::vector<T*> slabs;       ///< Выделенные блоки.
+    size_t used{0};              ///< Число занятых узлов в последнем блоке.
+    FreeSlot* freeList{nullptr}; ///< Список свободных ячеек.
+    size_t freeCount{0};         ///< Длина списка свободных ячеек.
+};
+
+/// @brief Подсказка процессору заранее загрузить строку кэша с адресом p.
+/// @param p Адрес, который скоро понадобится.
+inline void prefetch(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#elif defined(_M_X64) || defined(_M_IX86)
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+    (void)p;
+#endif
+}
+
+/// @brief Пакетный поиск в дереве с чередованием спусков.
+///
+/// Одновременно ведётся до kLanes спусков по дереву: за один проход каждый
+/// спуск делает шаг на один уровень и запрашивает prefetch следующего узла,
+/// так что промахи кэша разных ключей перекрываются.
+/// @tparam Node  Тип узла (поля key, values, left, right).
+/// @param root  Корень дерева.
+/// @param keys  Искомые ключи.
+/// @param visit Функция вида void(size_t keyIndex, const Object&).
+/// @return Общее число найденных объектов.
+template <class Node, class Visitor>
+size_t interleavedTreeSearch(const Node* root, std::span<const NameKey> keys, Visitor&& visit) {
+    constexpr size_t kLanes = 8;
+    size_t found = 0;
+    for (size_t base = 0; base < keys.size(); base += kLanes) {
+        const size_t lanes = std::min(kLanes, keys.size() - base);
+        const Node* cur[kLanes];
+        for (size_t i = 0; i < lanes; ++i) cur[i] = root;
+        for (bool active = root != nullptr; active; ) {
+            active = false;
+            for (size_t i = 0; i < lanes; ++i) {
+                const Node* n = cur[i];
+                if (!n) continue;
+                int cmp = keys[base + i].compare(n->key);
+                if (cmp == 0) {
+                    for (const auto& obj : n->values) visit(base + i, obj);
+                    found += n->values.size();
+                    cur[i] = nullptr;
+                    continue;
+                }
+                n = cmp < 0 ? n->left : n->right;
+                cur[i] = n;
+                if (n) {
+                    prefetch(n);
+                    active = true;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+/// @brief Находит объект с заданным id среди объектов одного ключа.
+/// @param values Объекты с одинаковым именем.
+/// @param id     Идентификатор объекта.
+/// @return Итератор на объект или values.end().
+inline std::vector<Object>::iterator findById(std::vector<Object>& values, size_t id) {
+    return std::find_if(values.begin(), values.end(), [id](const Object& o) { return o.id == id; });
+}
+
+/// @brief Первые 8 байт ключа как число big-endian (недостающие байты — нули).
+///
+/// Порядок префиксов согласован с лексикографическим порядком строк: если
+/// keyPrefix(a) < keyPrefix(b), то a < b; при равных префиксах строки нужно
+/// сравнить целиком.
+/// @param s Строка ключа.
+/// @return 64-битный префикс.
+inline uint64_t keyPrefix(std::string_view s) {
+    const size_t n = std::min<size_t>(s.size(), 8);
+    uint64_t p = 0;
+    for (size_t i = 0; i < n; ++i) {
+        p |= static_cast<uint64_t>(static_cast<unsigned char>(s[i])) << (56 - 8 * i);
+    }
+    return p;
+}
+
+/// @brief Первые 8 байт ключа как число big-endian (см. keyPrefix(std::string_view)).
+inline uint64_t keyPrefix(const NameKey& key) {
+    return keyPrefix(std::string_view(key.str()));
+}
+
+/// @brief Источник строк для пакетного построения индекса по массиву объектов:
+/// полезная нагрузка строки — копия объекта.
+struct ObjectRows {
+    const std::vector<Object>& data; ///< Объекты.
+
+    size_t size() const { return data.size(); }
+    std::string_view name(uint32_t row) const { return data[row].name.str(); }
+    const NameKey& key(uint32_t row) const { return data[row].name; }
+    const Object& value(uint32_t row) const { return data[row]; }
+};
+
+/// @brief Источник строк для пакетного построения индекса по колоночной таблице:
+/// полезная нагрузка строки — её номер.
+struct TableRows {
+    const ObjectTable& table; ///< Таблица объектов.
+
+    size_t size() const { return table.size(); }
+    std::string_view name(uint32_t row) const { return table.name(row); }
+    NameKey key(uint32_t row) const { return NameKey(std::string(table.name(row))); }
+    uint32_t value(uint32_t row) const { return row; }
+};
+
+/// @brief Вставляет в индекс номера всех строк таблицы (поштучно, в порядке строк).
+/// @param index Индекс с полезной нагрузкой uint32_t.
+/// @param table Таблица объектов.
+template <class Index>
+void insertRows(Index& index, const ObjectTable& table) {
+    const TableRows rows{table};
+    for (uint32_t row = 0; row < rows.size(); ++row) index.insert(rows.key(row), rows.value(row));
+}
+
+/// @brief Объекты, упорядоченные по имени и разбитые на группы с одинаковым именем.
+struct NameGroups {
+    std::vector<uint32_t> rows;   ///< Номера объектов по возрастанию имени (внутри имени — по номеру).
+    std::vector<size_t>   starts; ///< Начала групп в rows и в конце rows.size(): группа g — [starts[g], starts[g + 1]).
+};
+
+/// @brief Упорядочивает строки по имени и группирует дубликаты.
+///
+/// Сортируются пары (префикс имени, номер), а не сами объекты: большинство
+/// сравнений — сравнения 64-битных префиксов (keyPrefix) без обращения к строкам.
+/// @param rows Источник строк (ObjectRows или TableRows).
+/// @return Порядок и границы групп.
+template <class Rows>
+NameGroups groupByName(const Rows& rows) {
+    std::vector<std::pair<uint64_t, uint32_t>> order(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        order[i] = {keyPrefix(rows.name(static_cast<uint32_t>(i))), static_cast<uint32_t>(i)};
+    }
+    std::sort(order.begin(), order.end(), [&rows](const auto& a, const auto& b) {
+        if (a.first != b.first) return a.first < b.first;
+        int cmp = rows.name(a.second).compare(rows.name(b.second));
+        return cmp != 0 ? cmp < 0 : a.second < b.second;
+    });
+    NameGroups groups;
+    groups.rows.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        groups.rows[i] = order[i].second;
+        if (i == 0 || rows.name(order[i].second) != rows.name(order[i - 1].second)) groups.starts.push_back(i);
+    }
+    groups.starts.push_back(order.size());
+    return groups;
+}
+
+/// @brief Класс для реализации невыровненного бинарного дерева поиска (BST) по ключу name.
+///
+/// Поддерживает хранение нескольких объектов с одинаковым ключом в одном узле.
+/// @tparam Value Полезная нагрузка: Object (копия объекта) или uint32_t (номер
+///               строки ObjectTable; объект восстанавливается через таблицу).
+template <class Value = Object>
+class BinarySearchTree {
+public:
+    /// @brief Внутренняя структура узла BST.
+    struct Node {
+        NameKey            key;    ///< Ключевое поле (name).
+        std::vector<Value> values; ///< Все объекты (номера строк) с данным ключом.
+        Node*              left{nullptr};  ///< Левый потомок.
+        Node*              right{nullptr}; ///< Правый потомок.
+
+        /// @brief Конструктор узла.
+        /// @param name  Ключ.
+        /// @param value Объект (номер строки), который добавляется в values.
+        Node(const NameKey& name, const Value& value)
+                : key(name), values{value} {}
+    };
+
+    BinarySearchTree() = default;
+    BinarySearchTree(const BinarySearchTree&) = delete;
+    BinarySearchTree& operator=(const BinarySearchTree&) = delete;
+
+    /// @brief Вставляет объект в дерево поиска по его name.
+    /// @param obj Объект для вставки.
+    void insert(const Object& obj) { insert(obj.name, obj); }
+
+    /// @brief Вставляет полезную нагрузку по ключу.
+    ///
+    /// Если ключ уже есть — добавляет её в вектор существующего узла.
+    /// @param key   Ключ (name).
+    /// @param value Объект или номер строки.
+    void insert(const NameKey& key, const Value& value) {
+        if (!root) {
+            root = nodes.create(key, value);
+            return;
+        }
+        Node* cur = root;
+        while (true) {
+            int cmp = key.compare(cur->key);
+            if (cmp == 0) {
+                cur->values.push_back(value);
+                return;
+            }
+            if (cmp < 0) {
+                if (!cur->left) {
+                    cur->left = nodes.create(key, value);
+                    return;
+                }
+                cur = cur->left;
+            } else {
+                if (!cur->right) {
+                    cur->right = nodes.create(key, value);
+                    return;
+                }
+                cur = cur->right;
+            }
+        }
+    }
+
+    /// @brief Строит идеально сбалансированное дерево по набору объектов, заменяя содержимое.
+    ///
+    /// Объекты один раз упорядочиваются по имени (groupByName), дубликаты
+    /// группируются, затем дерево строится за линейное время: корень поддерева —
+    /// средняя группа. Узлы создаются в прямом порядке обхода (узел, левое
+    /// поддерево, правое), поэтому узел и его левый потомок лежат в арене рядом.
+    /// @param data Объекты (порядок объектов одного имени сохраняется).
+    void buildFrom(const std::vector<Object>& data) { buildRows(ObjectRows{data}); }
+
+    /// @brief То же по колоночной таблице: узлы хранят номера строк.
+    /// @param table Таблица объектов.
+    void buildFrom(const ObjectTable& table) { buildRows(TableRows{table}); }
+
+    /// @brief Осуществляет поиск всех объектов с заданным именем.
+    /// @param key Искомый ключ (name).
+    /// @return Вектор найденных объектов (может быть пустым).
+    std::vector<Object> search(const NameKey& key) const {
+        auto found = find(key);
+        return {found.begin(), found.end()};
+    }
+
+    /// @brief Поиск без копирования: возвращает представление объектов узла.
+    ///
+    /// Представление действительно до следующего изменения дерева.
+    /// @param key Искомый ключ (name).
+    /// @return Span найденных объектов или номеров строк (пустой, если ключа нет).
+    std::span<const Value> find(const NameKey& key) const {
+        Node* cur = root;
+        while (cur) {
+            int cmp = key.compare(cur->key);
+            if (cmp == 0) {
+                return cur->values;
+            }
+            if (cmp < 0) {
+                cur = cur->left;
+            } else {
+                cur = cur->right;
+            }
+        }
+        return {};
+    }
+
+    /// @brief Пакетный поиск: ищет все ключи из keys, чередуя спуски по дереву.
+    /// @param keys  Искомые ключи.
+    /// @param visit Функция вида void(size_t keyIndex, const Object&).
+    /// @return Общее число найденных объектов.
+    template <class Visitor>
+    size_t searchMany(std::span<const NameKey> keys, Visitor&& visit) const {
+        return interleavedTreeSearch<Node>(root, keys, visit);
+    }
+
+    /// @brief Удаляет все объекты с заданным именем вместе с их узлом.
+    /// @param key Имя.
+    /// @return Число удалённых объектов.
+    size_t erase(const NameKey& key) {
+        Node** link = findLink(key);
+        if (!*link) return 0;
+        const size_t removed = (*link)->values.size();
+        unlink(link);
+        return removed;
+    }
+
+    /// @brief Удаляет объект с заданными именем и id.
+    ///
+    /// Узел удаляется вместе с последним объектом своего ключа.
+    /// @param key Имя.
+    /// @param id  Идентификатор объекта.
+    /// @return true, если объект был найден и удалён.
+    bool erase(const NameKey& key, size_t id) {
+        Node** link = findLink(key);
+        if (!*link) return false;
+        auto& values = (*link)->values;
+        auto it = findById(values, id);
+        if (it == values.end()) return false;
+        values.erase(it);
+        if (values.empty()) unlink(link);
+        return true;
+    }
+
+    /// @brief Изменяет value объекта с заданными именем и id на месте.
+    /// @param key   Имя.
+    /// @param id    Идентификатор объекта.
+    /// @param value Новое значение.
+    /// @return true, если объект был найден.
+    bool updateValue(const NameKey& key, size_t id, double value) {
+        Node* n = *findLink(key);
+        if (!n) return false;
+        auto it = findById(n->values, id);
+        if (it == n->values.end()) return false;
+        it->value = value;
+        return true;
+    }
+
+    /// @brief Возвращает число узлов (различных ключей) в дереве.
+    size_t nodeCount() const { return nodes.size(); }
+
+    /// @brief Удаляет все узлы дерева.
+    void clear() {
+        nodes.clear();
+        root = nullptr;
+    }
+
+private:
+    Node*           root{nullptr}; ///< Корневой узел.
+    NodeArena<Node> nodes;         ///< Память всех узлов дерева.
+
+    /// @brief Пакетное построение по источнику строк (ObjectRows или TableRows).
+    template <class Rows>
+    void buildRows(const Rows& rows) {
+        clear();
+        const NameGroups groups = groupByName(rows);
+        root = buildRange(rows, groups, 0, groups.starts.size() - 1);
+    }
+
+    /// @brief Строит поддерево из групп [lo, hi).
+    template <class Rows>
+    Node* buildRange(const Rows& rows, const NameGroups& groups, size_t lo, size_t hi) {
+        if (lo >= hi) return nullptr;
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t first = groups.starts[mid], last = groups.starts[mid + 1];
+        Node* n = nodes.create(rows.key(groups.rows[first]), rows.value(groups.rows[first]));
+        n->values.reserve(last - first);
+        for (size_t i = first + 1; i < last; ++i) n->values.push_back(rows.value(groups.rows[i]));
+        n->left  = buildRange(rows, groups, lo, mid);
+        n->right = buildRange(rows, groups, mid + 1, hi);
+        return n;
+    }
+
+    /// @brief Находит ссылку (поле родителя или root), указывающую на узел ключа.
+    /// @param key Искомое имя.
+    /// @return Адрес указателя на узел; сам указатель равен nullptr, если ключа нет.
+    Node** findLink(const NameKey& key) {
+        Node** link = &root;
+        while (*link) {
+            int cmp = key.compare((*link)->key);
+            if (cmp == 0) break;
+            link = cmp < 0 ? &(*link)->left : &(*link)->right;
+        }
+        return link;
+    }
+
+    /// @brief Вырезает узел *link из дерева и возвращает его память арене.
+    ///
+    /// Узел с двумя потомками заменяется своим преемником (минимумом правого
+    /// поддерева): преемник перевешивается на место узла, данные не копируются.
+    /// @param link Ссылка на удаляемый узел.
+    void unlink(Node** link) {
+        Node* n = *link;
+        if (!n->left) {
+            *link = n->right;
+        } else if (!n->right) {
+            *link = n->left;
+        } else {
+            Node** succLink = &n->right;
+            while ((*succLink)->left) succLink = &(*succLink)->left;
+            Node* succ = *succLink;
+            *succLink = succ->right;
+            succ->left  = n->left;
+            succ->right = n->right;
+            *link = succ;
+        }
+        nodes.destroy(n);
+    }
+};
+
+/// @brief Класс красно-черного дерева (Red-Black Tree) для поиска по ключу name.
+///
+/// Гарантирует балансировку и поиск за O(log n).
+/// @tparam Value Полезная нагрузка: Object (копия объекта) или uint32_t (номер
+///               строки ObjectTable).
+template <class Value = Object>
+class RedBlackTree {
+public:
+    /// @brief Цвет узла.
+    enum Color { RED, BLACK };
+
+    /// @brief Структура узла красно-черного дерева.
+    struct Node {
+        NameKey            key;    ///< Ключ узла (name).
+        std::vector<Value> values; ///< Все объекты (номера строк) с данным ключом.
+        Color              color;  ///< Цвет узла.
+        Node*              left{nullptr};   ///< Левый потомок.
+        Node*              right{nullptr};  ///< Правый потомок.
+        Node*              parent{nullptr}; ///< Родитель.
+
+        /// @brief Конструктор узла.
+        /// @param name  Ключ.
+        /// @param value Объект (номер строки) для values.
+        /// @param c     Цвет (RED или BLACK).
+        /// @param p     Родительский узел.
+        Node(const NameKey& name, const Value& value, Color c, Node* p)
+                : key(name), values{value}, color(c), parent(p) {}
+    };
+
+    /// @brief Итератор по узлам в порядке возрастания ключей.
+    ///
+    /// Переход к следующему узлу идёт по указателям parent, без рекурсии и стека:
+    /// в среднем O(1), в худшем случае O(высота). Действителен до изменения дерева.
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Node;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Node*;
+        using reference         = const Node&;
+
+        Iterator() = default;
+        explicit Iterator(const Node* n) : node(n) {}
+
+        const Node& operator*() const { return *node; }
+        const Node* operator->() const { return node; }
+
+        Iterator& operator++() {
+            if (node->right) {
+                node = leftmost(node->right);
+            } else {
+                const Node* p = node->parent;
+                while (p && node == p->right) {
+                    node = p;
+                    p = p->parent;
+                }
+                node = p;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.node == b.node; }
+
+    private:
+        const Node* node{nullptr}; ///< Текущий узел (nullptr — конец).
+    };
+
+    RedBlackTree() = default;
+    RedBlackTree(const RedBlackTree&) = delete;
+    RedBlackTree& operator=(const RedBlackTree&) = delete;
+
+    /// @brief Вставляет объект в красно-черное дерево с балансировкой.
+    /// @param obj Объект для вставки.
+    void insert(const Object& obj) { insert(obj.name, obj); }
+
+    /// @brief Вставляет полезную нагрузку по ключу с балансировкой.
+    /// @param key   Ключ (name).
+    /// @param value Объект или номер строки.
+    void insert(const NameKey& key, const Value& value) {
+        if (!root) {
+            root = nodes.create(key, value, BLACK, nullptr);
+            return;
+        }
+        Node* cur = root;
+        Node* parent = nullptr;
+        int cmp = 0;
+        while (cur) {
+            parent = cur;
+            cmp = key.compare(cur->key);
+            if (cmp == 0) {
+                cur->values.push_back(value);
+                return;
+            }
+            cur = (cmp < 0 ? cur->left : cur->right);
+        }
+        Node* node = nodes.create(key, value, RED, parent);
+        if (cmp < 0) parent->left  = node;
+        else         parent->right = node;
+        insertFix(node);
+    }
+
+    /// @brief Строит дерево по набору объектов за линейное время, заменяя содержимое.
+    ///
+    /// Объекты один раз упорядочиваются по имени (groupByName), дубликаты
+    /// группируются, и дерево строится делением пополам, без поворотов. У такого дерева
+    /// высота h = floor(log2(число ключей)), а все пустые потомки лежат на
+    /// глубине h или h + 1, поэтому узлы самого нижнего уровня h красятся в
+    /// красный, остальные — в черный, и черная высота всех путей одинакова.
+    /// Узлы создаются в прямом порядке обхода.
+    /// @param data Объекты (порядок объектов одного имени сохраняется).
+    void buildFrom(const std::vector<Object>& data) { buildRows(ObjectRows{data}); }
+
+    /// @brief То же по колоночной таблице: узлы хранят номера строк.
+    /// @param table Таблица объектов.
+    void buildFrom(const ObjectTable& table) { buildRows(TableRows{table}); }
+
+    /// @brief Осуществляет поиск всех объектов с заданным именем.
+    /// @param key Искомое имя.
+    /// @return Вектор найденных объектов.
+    std::vector<Object> search(const NameKey& key) const {
+        auto found = find(key);
+        return {found.begin(), found.end()};
+    }
+
+    /// @brief Поиск без копирования: возвращает представление объектов узла.
+    ///
+    /// Представление действительно до следующего изменения дерева.
+    /// @param key Искомое имя.
+    /// @return Span найденных объектов или номеров строк (пустой, если ключа нет).
+    std::span<const Value> find(const NameKey& key) const {
+        Node* cur = root;
+        while (cur) {
+            int cmp = key.compare(cur->key);
+            if (cmp == 0) return cur->values;
+            cur = (cmp < 0 ? cur->left : cur->right);
+        }
+        return {};
+    }
+
+    /// @brief Пакетный поиск: ищет все ключи из keys, чередуя спуски по дереву.
+    /// @param keys  Искомые ключи.
+    /// @param visit Функция вида void(size_t keyIndex, const Object&).
+    /// @return Общее число найденных объектов.
+    template <class Visitor>
+    size_t searchMany(std::span<const NameKey> keys, Visitor&& visit) const {
+        return interleavedTreeSearch<Node>(root, keys, visit);
+    }
+
+    /// @brief Итератор на узел с наименьшим ключом.
+    Iterator begin() const { return Iterator(root ? leftmost(root) : nullptr); }
+
+    /// @brief Итератор за последним узлом.
+    Iterator end() const { return Iterator(); }
+
+    /// @brief Первый узел с ключом, не меньшим key.
+    /// @param key Граница.
+    /// @return Итератор на узел или end().
+    Iterator lowerBound(const NameKey& key) const {
+        const Node* result = nullptr;
+        for (const Node* cur = root; cur;) {
+            if (key.compare(cur->key) <= 0) {
+                result = cur;
+                cur = cur->left;
+            } else {
+                cur = cur->right;
+            }
+        }
+        return Iterator(result);
+    }
+
+    /// @brief Первый узел с ключом, строго большим key.
+    /// @param key Граница.
+    /// @return Итератор на узел или end().
+    Iterator upperBound(const NameKey& key) const {
+        const Node* result = nullptr;
+        for (const Node* cur = root; cur;) {
+            if (key.compare(cur->key) < 0) {
+                result = cur;
+                cur = cur->left;
+            } else {
+                cur = cur->right;
+            }
+        }
+        return Iterator(result);
+    }
+
+    /// @brief Обходит объекты с именами из полуинтервала [from, to) в порядке возрастания имён.
+    /// @param from  Нижняя граница (включительно).
+    /// @param to    Верхняя граница (не включительно).
+    /// @param visit Функция вида void(const Object&).
+    /// @return Число посещённых объектов.
+    template <class Visitor>
+    size_t rangeEach(const NameKey& from, const NameKey& to, Visitor&& visit) const {
+        size_t found = 0;
+        for (auto it = lowerBound(from); it != end() && it->key < to; ++it) {
+            for (const auto& obj : it->values) visit(obj);
+            found += it->values.size();
+        }
+        return found;
+    }
+
+    /// @brief Обходит объекты, имя которых начинается с prefix, в порядке возрастания имён.
+    ///
+    /// Все такие имена образуют непрерывный диапазон, начинающийся с lowerBound(prefix).
+    /// @param prefix Префикс имени.
+    /// @param visit  Функция вида void(const Object&).
+    /// @return Число посещённых объектов.
+    template <class Visitor>
+    size_t prefixEach(const NameKey& prefix, Visitor&& visit) const {
+        size_t found = 0;
+        for (auto it = lowerBound(prefix); it != end() && it->key.str().starts_with(prefix.str()); ++it) {
+            for (const auto& obj : it->values) visit(obj);
+            found += it->values.size();
+        }
+        return found;
+    }
+
+    /// @brief Удаляет все объекты с заданным именем вместе с их узлом.
+    /// @param key Имя.
+    /// @return Число удалённых объектов.
+    size_t erase(const NameKey& key) {
+        Node* n = findNode(key);
+        if (!n) return 0;
+        const size_t removed = n->values.size();
+        eraseNode(n);
+        return removed;
+    }
+
+    /// @brief Удаляет объект с заданными именем и id.
+    ///
+    /// Узел удаляется (с перебалансировкой) вместе с последним объектом своего ключа.
+    /// @param key Имя.
+    /// @param id  Идентификатор объекта.
+    /// @return true, если объект был найден и удалён.
+    bool erase(const NameKey& key, size_t id) {
+        Node* n = findNode(key);
+        if (!n) return false;
+        auto it = findById(n->values, id);
+        if (it == n->values.end()) return false;
+        n->values.erase(it);
+        if (n->values.empty()) eraseNode(n);
+        return true;
+    }
+
+    /// @brief Изменяет value объекта с заданными именем и id на месте.
+    /// @param key   Имя.
+    /// @param id    Идентификатор объекта.
+    /// @param value Новое значение.
+    /// @return true, если объект был найден.
+    bool updateValue(const NameKey& key, size_t id, double value) {
+        Node* n = findNode(key);
+        if (!n) return false;
+        auto it = findById(n->values, id);
+        if (it == n->values.end()) return false;
+        it->value = value;
+        return true;
+    }
+
+    /// @brief Возвращает число узлов (различных ключей) в дереве.
+    size_t nodeCount() const { return nodes.size(); }
+
+    /// @brief Удаляет все узлы дерева.
+    void clear() {
+        nodes.clear();
+        root = nullptr;
+    }
+
+private:
+    Node*           root{nullptr}; ///< Корень дерева.
+    NodeArena<Node> nodes;         ///< Память всех узлов дерева.
+
+    /// @brief Узел с наименьшим ключом в поддереве n.
+    static const Node* leftmost(const Node* n) {
+        while (n->left) n = n->left;
+        return n;
+    }
+
+    /// @brief Находит узел ключа.
+    /// @param key Искомое имя.
+    /// @return Узел или nullptr.
+    Node* findNode(const NameKey& key) const {
+        Node* cur = root;
+        while (cur) {
+            int cmp = key.compare(cur->key);
+            if (cmp == 0) return cur;
+            cur = (cmp < 0 ? cur->left : cur->right);
+        }
+        return nullptr;
+    }
+
+    /// @brief Пакетное построение по источнику строк (ObjectRows или TableRows).
+    template <class Rows>
+    void buildRows(const Rows& rows) {
+        clear();
+        const NameGroups groups = groupByName(rows);
+        const size_t keys = groups.starts.size() - 1;
+        const size_t redDepth = keys > 1 ? static_cast<size_t>(std::bit_width(keys) - 1) : SIZE_MAX;
+        root = buildRange(rows, groups, 0, keys, nullptr, 0, redDepth);
+    }
+
+    /// @brief Строит поддерево из групп [lo, hi); узлы на глубине redDepth — красные.
+    template <class Rows>
+    Node* buildRange(const Rows& rows, const NameGroups& groups, size_t lo, size_t hi,
+                     Node* parent, size_t depth, size_t redDepth) {
+        if (lo >= hi) return nullptr;
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t first = groups.starts[mid], last = groups.starts[mid + 1];
+        Node* n = nodes.create(rows.key(groups.rows[first]), rows.value(groups.rows[first]),
+                               depth == redDepth ? RED : BLACK, parent);
+        n->values.reserve(last - first);
+        for (size_t i = first + 1; i < last; ++i) n->values.push_back(rows.value(groups.rows[i]));
+        n->left  = buildRange(rows, groups, lo, mid, n, depth + 1, redDepth);
+        n->right = buildRange(rows, groups, mid + 1, hi, n, depth + 1, redDepth);
+        return n;
+    }
+
+    /// @brief Удаляет узел z из дерева с восстановлением баланса и освобождает его.
+    ///
+    /// Если у z два потомка, на его место перевешивается преемник y (минимум
+    /// правого поддерева) и получает цвет z; фактически из дерева уходит позиция y.
+    /// Если уходящая позиция была черной, вызывается eraseFix.
+    /// @param z Удаляемый узел.
+    void eraseNode(Node* z) {
+        Node* x = nullptr;       // узел, занявший освободившуюся позицию (может быть nullptr)
+        Node* xParent = nullptr; // его родитель
+        Color removedColor = z->color;
+        if (!z->left) {
+            x = z->right;
+            xParent = z->parent;
+            transplant(z, z->right);
+        } else if (!z->right) {
+            x = z->left;
+            xParent = z->parent;
+            transplant(z, z->left);
+        } else {
+            Node* y = z->right;
+            while (y->left) y = y->left;
+            removedColor = y->color;
+            x = y->right;
+            if (y->parent == z) {
+                xParent = y;
+            } else {
+                xParent = y->parent;
+                transplant(y, y->right);
+                y->right = z->right;
+                y->right->parent = y;
+            }
+            transplant(z, y);
+            y->left = z->left;
+            y->left->parent = y;
+            y->color = z->color;
+        }
+        nodes.destroy(z);
+        if (removedColor == BLACK) eraseFix(x, xParent);
+    }
+
+    /// @brief Восстанавливает баланс после удаления черной позиции.
+    ///
+    /// x несёт «лишний черный»; пустые потомки (nullptr) считаются черными.
+    /// @param x       Узел на месте удалённого (может быть nullptr).
+    /// @param xParent Родитель x.
+    void eraseFix(Node* x, Node* xParent) {
+        auto isBlack = [](const Node* n) { return !n || n->color == BLACK; };
+        while (x != root && isBlack(x)) {
+            if (x == xParent->left) {
+                Node* w = xParent->right;
+                if (w->color == RED) {
+                    // Случай 1: красный брат — поворот, брат становится черным
+                    w->color = BLACK;
+                    xParent->color = RED;
+                    rotateLeft(xParent);
+                    w = xParent->right;
+                }
+                if (isBlack(w->left) && isBlack(w->right)) {
+                    // Случай 2: оба племянника черные — перекраска, подъём вверх
+                    w->color = RED;
+                    x = xParent;
+                    xParent = x->parent;
+                } else {
+                    if (isBlack(w->right)) {
+                        // Случай 3: дальний племянник черный — поворот вокруг брата
+                        w->left->color = BLACK;
+                        w->color = RED;
+                        rotateRight(w);
+                        w = xParent->right;
+                    }
+                    // Случай 4: дальний племянник красный — поворот вокруг родителя
+                    w->color = xParent->color;
+                    xParent->color = BLACK;
+                    w->right->color = BLACK;
+                    rotateLeft(xParent);
+                    x = root;
+                }
+            } else {
+                // Симметричные случаи, когда x — правый ребёнок
+                Node* w = xParent->left;
+                if (w->color == RED) {
+                    w->color = BLACK;
+                    xParent->color = RED;
+                    rotateRight(xParent);
+                    w = xParent->left;
+                }
+                if (isBlack(w->left) && isBlack(w->right)) {
+                    w->color = RED;
+                    x = xParent;
+                    xParent = x->parent;
+                } else {
+                    if (isBlack(w->left)) {
+                        w->right->color = BLACK;
+                        w->color = RED;
+                        rotateLeft(w);
+                        w = xParent->left;
+                    }
+                    w->color = xParent->color;
+                    xParent->color = BLACK;
+                    w->left->color = BLACK;
+                    rotateRight(xParent);
+                    x = root;
+                }
+            }
+        }
+        if (x) x->color = BLACK;
+    }
+
+    /// @brief Восстанавливает баланс после вставки узла.
+    /// @param n Вставленный узел.
+    void insertFix(Node* n) {
+        while (n != root && n->parent->color == RED) {
+            Node* p = n->parent;
+            Node* g = p->parent;
+            if (p == g->left) {
+                Node* u = g->right;
+                if (u && u->color == RED) {
+                    // Случай 1: перекраска
+                    p->color = BLACK;
+                    u->color = BLACK;
+                    g->color = RED;
+                    n = g;
+                } else {
+                    if (n == p->right) {
+                        // Случай 2: левый поворот вокруг p
+                        n = p;
+                        rotateLeft(n);
+                        p = n->parent;
+                        g = p->parent;
+                    }
+                    // Случай 3: правый поворот вокруг g
+                    p->color = BLACK;
+                    g->color = RED;
+                    rotateRight(g);
+                }
+            } else {
+                // Симметричные случаи, когда p — правый ребёнок g
+                Node* u = g->left;
+                if (u && u->color == RED) {
+                    p->color = BLACK;
+                    u->color = BLACK;
+                    g->color = RED;
+                    n = g;
+                } else {
+                    if (n == p->left) {
+                        n = p;
+                        rotateRight(n);
+                        p = n->parent;
+                        g = p->parent;
+                    }
+                    p->color = BLACK;
+                    g->color = RED;
+                    rotateLeft(g);
+                }
+            }
+        }
+        root->color = BLACK;  // корень всегда черный
+    }
+
+    /// @brief Левый поворот поддерева вокруг узла x.
+    /// @param x Узел, вокруг которого крутят влево.
+    void rotateLeft(Node* x) {
+        Node* y = x->right;
+        x->right = y->left;
+        if (y->left) y->left->parent = x;
+        transplant(x, y);
+        y->left   = x;
+        x->parent = y;
+    }
+
+    /// @brief Правый поворот поддерева вокруг узла x.
+    /// @param x Узел, вокруг которого крутят вправо.
+    void rotateRight(Node* x) {
+        Node* y = x->left;
+        x->left = y->right;
+        if (y->right) y->right->parent = x;
+        transplant(x, y);
+        y->right  = x;
+        x->parent = y;
     }
 
     /// @brief Вспомогательная замена поддерева u на v.
@@ -309,74 +2000,1736 @@ private:
         else                            u->parent->right = v;
         if (v) v->parent = u->parent;
     }
+};
+
+/// @brief Эпохи для отложенного освобождения памяти (epoch-based reclamation).
+///
+/// Читатель на время работы с разделяемыми данными объявляет текущую глобальную
+/// эпоху в свободном слоте (Guard). Писатель, убрав узел из структуры, помечает
+/// его текущей эпохой и увеличивает её; узел можно освободить, когда все активные
+/// читатели объявили эпоху больше отметки узла — они начали читать уже после
+/// того, как узел стал недостижим.
+class EpochManager {
+public:
+    static constexpr size_t kMaxReaders = 64; ///< Максимум одновременно активных читателей.
+
+    /// @brief RAII-объявление эпохи читателем.
+    class Guard {
+    public:
+        /// @brief Занимает свободный слот и объявляет в нём текущую эпоху.
+        explicit Guard(const EpochManager& mgr) : owner(mgr) {
+            thread_local size_t hint = 0;
+            for (size_t attempt = 1; ; ++attempt) {
+                const size_t i = (hint + attempt - 1) % kMaxReaders;
+                uint64_t expected = 0;
+                if (owner.slots[i].announced.compare_exchange_strong(expected, owner.global.load())) {
+                    slot = i;
+                    hint = i;
+                    return;
+                }
+                if (attempt % kMaxReaders == 0) std::this_thread::yield(); // все слоты заняты
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard() { owner.slots[slot].announced.store(0, std::memory_order_release); }
+
+    private:
+        const EpochManager& owner; ///< Менеджер эпох.
+        size_t slot{0};            ///< Занятый слот.
+    };
+
+    /// @brief Возвращает эпоху, которой помечается снятый узел, и начинает новую.
+    uint64_t advance() { return global.fetch_add(1); }
+
+    /// @brief Возвращает минимальную эпоху среди активных читателей (UINT64_MAX, если их нет).
+    uint64_t minActive() const {
+        uint64_t result = UINT64_MAX;
+        for (const auto& s : slots) {
+            uint64_t e = s.announced.load();
+            if (e != 0) result = std::min(result, e);
+        }
+        return result;
+    }
+
+private:
+    /// @brief Слот читателя на отдельной строке кэша; 0 — слот свободен.
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> announced{0}; ///< Объявленная эпоха.
+    };
+
+    std::atomic<uint64_t> global{1};               ///< Глобальная эпоха (начинается с 1).
+    mutable std::array<Slot, kMaxReaders> slots{}; ///< Слоты читателей.
+};
+
+/// @brief Персистентное красно-черное дерево с копированием пути (copy-on-write).
+///
+/// Опубликованные узлы никогда не изменяются: вставка копирует путь от корня до
+/// места вставки, балансирует копии (схема Окасаки) и атомарно публикует новый
+/// корень. Читатели берут Snapshot — зафиксированный корень под защитой эпохи —
+/// и работают с ним без блокировок, пока писатель строит следующие версии.
+/// Заменённые узлы старых версий освобождаются через EpochManager, когда ни один
+/// читатель уже не может их видеть. Писатели упорядочиваются мьютексом.
+class PersistentRedBlackTree {
+    struct Node;
+
+public:
+    /// @brief Неизменяемая версия дерева, доступная читателю без блокировок.
+    class Snapshot {
+    public:
+        /// @brief Поиск без копирования в зафиксированной версии.
+        /// @param key Искомое имя.
+        /// @return Span найденных объектов (действителен, пока жив Snapshot).
+        std::span<const Object> find(const NameKey& key) const {
+            const Node* cur = root;
+            while (cur) {
+                int cmp = key.compare(cur->key);
+                if (cmp == 0) return *cur->values;
+                cur = (cmp < 0 ? cur->left : cur->right);
+            }
+            return {};
+        }
+
+    private:
+        friend class PersistentRedBlackTree;
+
+        /// @brief Фиксирует текущий корень дерева.
+        explicit Snapshot(const PersistentRedBlackTree& tree)
+                : guard(tree.epochs), root(tree.root.load()) {}
+
+        EpochManager::Guard guard; ///< Объявленная эпоха (держит узлы версии живыми).
+        const Node*         root;  ///< Корень зафиксированной версии.
+    };
+
+    PersistentRedBlackTree() = default;
+    PersistentRedBlackTree(const PersistentRedBlackTree&) = delete;
+    PersistentRedBlackTree& operator=(const PersistentRedBlackTree&) = delete;
+
+    ~PersistentRedBlackTree() {
+        for (const auto& r : retired) delete r.node;
+        destroy(root.load());
+    }
+
+    /// @brief Вставляет объект, публикуя новую версию дерева.
+    /// @param obj Объект для вставки.
+    void insert(const Object& obj) {
+        std::lock_guard<std::mutex> lock(writeLock);
+        std::vector<const Node*> replaced;
+        Node* newRoot = ins(root.load(std::memory_order_relaxed), obj, replaced);
+        newRoot->color = BLACK;
+        root.store(newRoot);
+        const uint64_t epoch = epochs.advance();
+        for (const Node* n : replaced) retired.push_back({n, epoch});
+        if (retired.size() >= kReclaimBatch) reclaim();
+    }
+
+    /// @brief Фиксирует текущую версию для чтения.
+    Snapshot snapshot() const { return Snapshot(*this); }
+
+    /// @brief Поиск в текущей версии: вызывает visit для каждого найденного объекта.
+    /// @param key   Искомое имя.
+    /// @param visit Функция вида void(const Object&).
+    /// @return Число найденных объектов.
+    template <class Visitor>
+    size_t searchEach(const NameKey& key, Visitor&& visit) const {
+        Snapshot snap(*this);
+        auto found = snap.find(key);
+        for (const auto& obj : found) visit(obj);
+        return found.size();
+    }
+
+    /// @brief Осуществляет поиск всех объектов с заданным именем.
+    /// @param key Искомое имя.
+    /// @return Вектор найденных объектов.
+    std::vector<Object> search(const NameKey& key) const {
+        Snapshot snap(*this);
+        auto found = snap.find(key);
+        return {found.begin(), found.end()};
+    }
+
+    /// @brief Возвращает число узлов, ожидающих освобождения.
+    size_t pendingReclaim() const {
+        std::lock_guard<std::mutex> lock(writeLock);
+        return retired.size();
+    }
+
+private:
+    /// @brief Цвет узла.
+    enum Color { RED, BLACK };
+
+    /// @brief Узел; после публикации не изменяется. Массив объектов разделяется
+    /// копиями узла и заменяется только при вставке объекта с этим ключом.
+    struct Node {
+        NameKey                                    key;            ///< Ключ узла (name).
+        std::shared_ptr<const std::vector<Object>> values;         ///< Все объекты с данным ключом.
+        Color                                      color;          ///< Цвет узла.
+        const Node*                                left{nullptr};  ///< Левый потомок.
+        const Node*                                right{nullptr}; ///< Правый потомок.
+    };
+
+    /// @brief Снятый узел и эпоха, после которой его можно освободить.
+    struct Retired {
+        const Node* node;  ///< Узел.
+        uint64_t    epoch; ///< Эпоха снятия.
+    };
+
+    static constexpr size_t kReclaimBatch = 256; ///< Размер пачки для попытки освобождения.
+
+    std::atomic<const Node*> root{nullptr}; ///< Корень текущей версии.
+    mutable std::mutex       writeLock;     ///< Упорядочивает писателей.
+    EpochManager             epochs;        ///< Эпохи читателей.
+    std::vector<Retired>     retired;       ///< Узлы старых версий, ожидающие освобождения.
+
+    /// @brief Рекурсивная вставка с копированием пути.
+    /// @param n        Корень поддерева текущей версии.
+    /// @param obj      Вставляемый объект.
+    /// @param replaced Сюда добавляются скопированные (заменённые) узлы.
+    /// @return Новый (ещё не опубликованный) корень поддерева.
+    Node* ins(const Node* n, const Object& obj, std::vector<const Node*>& replaced) {
+        if (!n) {
+            return new Node{obj.name, std::make_shared<const std::vector<Object>>(1, obj), RED};
+        }
+        replaced.push_back(n);
+        Node* copy = new Node(*n);
+        int cmp = obj.name.compare(n->key);
+        if (cmp == 0) {
+            auto values = std::make_shared<std::vector<Object>>(*n->values);
+            values->push_back(obj);
+            copy->values = std::move(values);
+            return copy;
+        }
+        if (cmp < 0) copy->left  = ins(n->left, obj, replaced);
+        else         copy->right = ins(n->right, obj, replaced);
+        return balance(copy);
+    }
+
+    /// @brief Устраняет два красных узла подряд под чёрным узлом z (схема Окасаки).
+    ///
+    /// Нарушение возможно только на только что скопированном пути, поэтому
+    /// перестраиваемые узлы ещё не опубликованы и меняются на месте.
+    /// @param z Новый узел.
+    /// @return Новый корень поддерева.
+    static Node* balance(Node* z) {
+        if (z->color != BLACK) return z;
+        auto red = [](const Node* n) { return n && n->color == RED; };
+        auto fresh = [](const Node* n) { return const_cast<Node*>(n); };
+        Node *x, *y, *top;
+        if (red(z->left) && red(z->left->left)) {
+            y = fresh(z->left); x = fresh(y->left);
+            z->left = y->right;
+            y->left = x; y->right = z; top = y;
+            x->color = BLACK; z->color = BLACK;
+        } else if (red(z->left) && red(z->left->right)) {
+            x = fresh(z->left); y = fresh(x->right);
+            x->right = y->left; z->left = y->right;
+            y->left = x; y->right = z; top = y;
+            x->color = BLACK; z->color = BLACK;
+        } else if (red(z->right) && red(z->right->left)) {
+            Node* r = fresh(z->right); y = fresh(r->left);
+            z->right = y->left; r->left = y->right;
+            y->left = z; y->right = r; top = y;
+            z->color = BLACK; r->color = BLACK;
+        } else if (red(z->right) && red(z->right->right)) {
+            y = fresh(z->right); x = fresh(y->right);
+            z->right = y->left;
+            y->left = z; y->right = x; top = y;
+            z->color = BLACK; x->color = BLACK;
+        } else {
+            return z;
+        }
+        top->color = RED;
+        return top;
+    }
+
+    /// @brief Освобождает снятые узлы, которые уже не видит ни один читатель.
+    void reclaim() {
+        const uint64_t safe = epochs.minActive();
+        size_t kept = 0;
+        for (const auto& r : retired) {
+            if (r.epoch < safe) delete r.node;
+            else                retired[kept++] = r;
+        }
+        retired.resize(kept);
+    }
+
+    /// @brief Рекурсивно удаляет поддерево текущей версии.
+    static void destroy(const Node* n) {
+        if (!n) return;
+        destroy(n->left);
+        destroy(n->right);
+        delete n;
+    }
+};
+
+/// @brief B+-дерево по ключу name с узлами размером в несколько строк кэша.
+///
+/// Внутренний узел и лист занимают по 256 байт (4 строки кэша) и хранят
+/// отсортированные 64-битные префиксы ключей (keyPrefix), так что выбор потомка
+/// обычно требует только сравнения чисел внутри одного узла; полные строки
+/// сравниваются лишь при равных префиксах. При спуске все строки следующего
+/// узла запрашиваются prefetch'ем сразу. Объекты одного ключа лежат в отдельной
+/// записи (Entry), лист хранит указатели на записи. Листья связаны в список по
+/// возрастанию ключей, поэтому диапазонный обход — последовательный проход по
+/// листьям без возврата к корню. Удаления нет: записи не перемещаются, и
+/// разделители внутренних узлов ссылаются прямо на ключи записей.
+/// @tparam Value Полезная нагрузка: Object (копия объекта) или uint32_t (номер
+///               строки ObjectTable).
+template <class Value = Object>
+class BPlusTree {
+public:
+    BPlusTree() = default;
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    /// @brief Вставляет объект по его name.
+    /// @param obj Объект для вставки.
+    void insert(const Object& obj) { insert(obj.name, obj); }
+
+    /// @brief Вставляет полезную нагрузку по ключу; при переполнении узлы делятся пополам снизу вверх.
+    /// @param key   Ключ (name).
+    /// @param value Объект или номер строки.
+    void insert(const NameKey& key, const Value& value) {
+        const uint64_t p = keyPrefix(key);
+        if (!root) {
+            root = leaves.create();
+            depth = 0;
+        }
+        Inner* path[kMaxDepth];
+        size_t slot[kMaxDepth];
+        void* node = root;
+        for (size_t level = 0; level < depth; ++level) {
+            auto* in = static_cast<Inner*>(node);
+            slot[level] = in->childIndex(p, key);
+            path[level] = in;
+            node = in->children[slot[level]];
+        }
+        auto* leaf = static_cast<Leaf*>(node);
+        const size_t i = leaf->lowerBound(p, key);
+        if (i < leaf->count && leaf->prefixes[i] == p && leaf->entries[i]->key == key) {
+            leaf->entries[i]->values.push_back(value);
+            return;
+        }
+        Entry* e = entries.create(key, value);
+        if (leaf->count < kLeafKeys) {
+            leaf->insertAt(i, p, e);
+            return;
+        }
+
+        // Лист полон: правая половина уходит в новый лист, его первый ключ — разделитель.
+        Leaf* right = leaves.create();
+        constexpr size_t kLeftKeys = (kLeafKeys + 1) / 2;
+        const bool toLeft = i < kLeftKeys;
+        const size_t moveFrom = toLeft ? kLeftKeys - 1 : kLeftKeys;
+        right->count = static_cast<uint32_t>(kLeafKeys - moveFrom);
+        std::copy_n(leaf->prefixes + moveFrom, right->count, right->prefixes);
+        std::copy_n(leaf->entries + moveFrom, right->count, right->entries);
+        leaf->count = static_cast<uint32_t>(moveFrom);
+        if (toLeft) leaf->insertAt(i, p, e);
+        else        right->insertAt(i - moveFrom, p, e);
+        right->next = leaf->next;
+        leaf->next = right;
+
+        uint64_t sepPrefix = right->prefixes[0];
+        const NameKey* sepKey = &right->entries[0]->key;
+        void* child = right;
+        for (size_t level = depth; level-- > 0;) {
+            Inner* in = path[level];
+            const size_t pos = slot[level];
+            if (in->count < kInnerKeys) {
+                in->insertAt(pos, sepPrefix, sepKey, child);
+                return;
+            }
+            // Внутренний узел полон: средний разделитель поднимается на уровень выше.
+            uint64_t prefixes[kInnerKeys + 1];
+            const NameKey* keys[kInnerKeys + 1];
+            void* children[kInnerKeys + 2];
+            std::copy_n(in->prefixes, pos, prefixes);
+            std::copy_n(in->keys, pos, keys);
+            prefixes[pos] = sepPrefix;
+            keys[pos] = sepKey;
+            std::copy(in->prefixes + pos, in->prefixes + kInnerKeys, prefixes + pos + 1);
+            std::copy(in->keys + pos, in->keys + kInnerKeys, keys + pos + 1);
+            std::copy_n(in->children, pos + 1, children);
+            children[pos + 1] = child;
+            std::copy(in->children + pos + 1, in->children + kInnerKeys + 1, children + pos + 2);
+
+            constexpr size_t kMid = (kInnerKeys + 1) / 2;
+            Inner* sibling = inners.create();
+            in->count = static_cast<uint32_t>(kMid);
+            std::copy_n(prefixes, kMid, in->prefixes);
+            std::copy_n(keys, kMid, in->keys);
+            std::copy_n(children, kMid + 1, in->children);
+            sibling->count = static_cast<uint32_t>(kInnerKeys - kMid);
+            std::copy_n(prefixes + kMid + 1, sibling->count, sibling->prefixes);
+            std::copy_n(keys + kMid + 1, sibling->count, sibling->keys);
+            std::copy_n(children + kMid + 1, sibling->count + 1, sibling->children);
+            sepPrefix = prefixes[kMid];
+            sepKey = keys[kMid];
+            child = sibling;
+        }
+        Inner* newRoot = inners.create();
+        newRoot->count = 1;
+        newRoot->prefixes[0] = sepPrefix;
+        newRoot->keys[0] = sepKey;
+        newRoot->children[0] = root;
+        newRoot->children[1] = child;
+        root = newRoot;
+        ++depth;
+    }
+
+    /// @brief Осуществляет поиск всех объектов с заданным именем.
+    /// @param key Искомое имя.
+    /// @return Вектор найденных объектов.
+    std::vector<Object> search(const NameKey& key) const {
+        auto found = find(key);
+        return {found.begin(), found.end()};
+    }
+
+    /// @brief Поиск без копирования: возвращает представление объектов ключа.
+    ///
+    /// Представление действительно до следующей вставки объекта с этим ключом.
+    /// @param key Искомое имя.
+    /// @return Span найденных объектов или номеров строк (пустой, если ключа нет).
+    std::span<const Value> find(const NameKey& key) const {
+        if (!root) return {};
+        const uint64_t p = keyPrefix(key);
+        const Leaf* leaf = findLeaf(p, key);
+        const size_t i = leaf->lowerBound(p, key);
+        if (i < leaf->count && leaf->prefixes[i] == p && leaf->entries[i]->key == key) {
+            return leaf->entries[i]->values;
+        }
+        return {};
+    }
+
+    /// @brief Обходит объекты с именами из полуинтервала [from, to) в порядке возрастания имён.
+    /// @param from  Нижняя граница (включительно).
+    /// @param to    Верхняя граница (не включительно).
+    /// @param visit Функция вида void(const Object&).
+    /// @return Число посещённых объектов.
+    template <class Visitor>
+    size_t scanRange(const NameKey& from, const NameKey& to, Visitor&& visit) const {
+        if (!root) return 0;
+        const uint64_t p = keyPrefix(from);
+        const Leaf* leaf = findLeaf(p, from);
+        size_t found = 0;
+        for (size_t i = leaf->lowerBound(p, from); leaf; leaf = leaf->next, i = 0) {
+            if (leaf->next) prefetchNode(leaf->next);
+            for (; i < leaf->count; ++i) {
+                const Entry* e = leaf->entries[i];
+                if (!(e->key < to)) return found;
+                for (const auto& obj : e->values) visit(obj);
+                found += e->values.size();
+            }
+        }
+        return found;
+    }
+
+    /// @brief Возвращает число различных ключей.
+    size_t keyCount() const { return entries.size(); }
+
+    /// @brief Возвращает число уровней внутренних узлов над листьями.
+    size_t height() const { return depth; }
+
+    /// @brief Удаляет все узлы и записи дерева.
+    void clear() {
+        inners.clear();
+        leaves.clear();
+        entries.clear();
+        root = nullptr;
+        depth = 0;
+    }
+
+private:
+    static constexpr size_t kLeafKeys  = 14; ///< Ключей в листе.
+    static constexpr size_t kInnerKeys = 10; ///< Разделителей во внутреннем узле (потомков на 1 больше).
+    static constexpr size_t kMaxDepth  = 32; ///< Предел высоты (при половинном заполнении узлов недостижим).
+
+    /// @brief Все объекты одного ключа.
+    struct Entry {
+        NameKey            key;    ///< Ключ (name).
+        std::vector<Value> values; ///< Объекты (номера строк) с данным ключом.
+
+        /// @brief Создаёт запись с первым объектом ключа.
+        Entry(const NameKey& name, const Value& value) : key(name), values{value} {}
+    };
+
+    /// @brief Лист: отсортированные префиксы и указатели на записи.
+    struct alignas(64) Leaf {
+        uint32_t count{0};            ///< Число ключей.
+        Leaf*    next{nullptr};       ///< Следующий лист по возрастанию ключей.
+        uint64_t prefixes[kLeafKeys]; ///< Префиксы ключей.
+        Entry*   entries[kLeafKeys];  ///< Записи ключей.
+
+        /// @brief Позиция первого ключа, не меньшего key.
+        size_t lowerBound(uint64_t p, const NameKey& key) const {
+            size_t i = 0;
+            while (i < count && (prefixes[i] < p || (prefixes[i] == p && entries[i]->key.compare(key) < 0))) ++i;
+            return i;
+        }
+
+        /// @brief Вставляет запись в позицию i со сдвигом хвоста.
+        void insertAt(size_t i, uint64_t p, Entry* e) {
+            std::copy_backward(prefixes + i, prefixes + count, prefixes + count + 1);
+            std::copy_backward(entries + i, entries + count, entries + count + 1);
+            prefixes[i] = p;
+            entries[i] = e;
+            ++count;
+        }
+    };
+
+    /// @brief Внутренний узел: разделитель i — наименьший ключ поддерева children[i + 1].
+    struct alignas(64) Inner {
+        uint32_t       count{0};                 ///< Число разделителей.
+        uint64_t       prefixes[kInnerKeys];     ///< Префиксы разделителей.
+        const NameKey* keys[kInnerKeys];         ///< Полные ключи разделителей (в записях).
+        void*          children[kInnerKeys + 1]; ///< Потомки: Inner* или Leaf* на нижнем уровне.
+
+        /// @brief Номер потомка, в поддереве которого лежит key (число разделителей <= key).
+        size_t childIndex(uint64_t p, const NameKey& key) const {
+            size_t i = 0;
+            while (i < count && (prefixes[i] < p || (prefixes[i] == p && keys[i]->compare(key) <= 0))) ++i;
+            return i;
+        }
+
+        /// @brief Вставляет разделитель в позицию i и правого от него потомка.
+        void insertAt(size_t i, uint64_t p, const NameKey* key, void* child) {
+            std::copy_backward(prefixes + i, prefixes + count, prefixes + count + 1);
+            std::copy_backward(keys + i, keys + count, keys + count + 1);
+            std::copy_backward(children + i + 1, children + count + 1, children + count + 2);
+            prefixes[i] = p;
+            keys[i] = key;
+            children[i + 1] = child;
+            ++count;
+        }
+    };
+    static_assert(sizeof(Leaf) == 256 && sizeof(Inner) == 256, "узлы B+-дерева должны занимать 4 строки кэша");
+
+    void*            root{nullptr}; ///< Корень: Inner* при depth > 0, иначе Leaf*.
+    size_t           depth{0};      ///< Число уровней внутренних узлов.
+    NodeArena<Inner> inners;        ///< Память внутренних узлов.
+    NodeArena<Leaf>  leaves;        ///< Память листьев.
+    NodeArena<Entry> entries;       ///< Память записей.
+
+    /// @brief Запрашивает все строки кэша узла.
+    template <class Node>
+    static void prefetchNode(const Node* n) {
+        for (size_t off = 0; off < sizeof(Node); off += 64) {
+            prefetch(reinterpret_cast<const char*>(n) + off);
+        }
+    }
+
+    /// @brief Спускается от корня до листа, в котором должен лежать ключ.
+    const Leaf* findLeaf(uint64_t p, const NameKey& key) const {
+        const void* node = root;
+        for (size_t level = 0; level < depth; ++level) {
+            const auto* in = static_cast<const Inner*>(node);
+            node = in->children[in->childIndex(p, key)];
+            if (level + 1 < depth) prefetchNode(static_cast<const Inner*>(node));
+            else                   prefetchNode(static_cast<const Leaf*>(node));
+        }
+        return static_cast<const Leaf*>(node);
+    }
+};
+
+/// @brief Адаптивное радиксное дерево (Adaptive Radix Tree) по байтам ключа name.
+///
+/// Спуск идёт по байтам ключа, а не сравнениями строк, поэтому поиск занимает
+/// O(длина ключа) независимо от числа ключей. Размер узла подстраивается под
+/// число потомков: Node4 и Node16 хранят отсортированные байты-метки (Node16
+/// ищет метку одной SSE2-инструкцией), Node48 — таблицу 256 байт-индексов в 48
+/// слотов, Node256 — прямой массив указателей. Цепочки узлов с единственным
+/// потомком сжимаются в префикс узла (path compression): хранятся первые
+/// kMaxPrefix байт, остальные при поиске пропускаются, а полный ключ
+/// проверяется в листе. Ключ, являющийся префиксом других, хранится в поле
+/// terminal узла, где он заканчивается. Указатель на лист помечается младшим
+/// битом. Узлы лежат в аренах по типам; при росте узел заменяется следующим
+/// по размеру, а память старого возвращается в арену.
+/// @tparam Value Полезная нагрузка: Object (копия объекта) или uint32_t (номер
+///               строки ObjectTable).
+template <class Value = Object>
+class AdaptiveRadixTree {
+public:
+    AdaptiveRadixTree() = default;
+    AdaptiveRadixTree(const AdaptiveRadixTree&) = delete;
+    AdaptiveRadixTree& operator=(const AdaptiveRadixTree&) = delete;
+
+    /// @brief Вставляет объект в дерево по его name.
+    /// @param obj Объект для вставки.
+    void insert(const Object& obj) { insert(obj.name, obj); }
+
+    /// @brief Вставляет полезную нагрузку по ключу.
+    ///
+    /// Если ключ уже есть — добавляет её к значениям его листа.
+    /// @param key   Ключ (name).
+    /// @param value Объект или номер строки.
+    void insert(const NameKey& key, const Value& value) {
+        if (Leaf* existing = const_cast<Leaf*>(findLeaf(key))) {
+            existing->values.push_back(value);
+            return;
+        }
+        insertLeaf(&root, leaves.create(key, value), 0);
+    }
+
+    /// @brief Осуществляет поиск всех объектов с заданным именем.
+    /// @param key Искомое имя.
+    /// @return Вектор найденных объектов.
+    std::vector<Object> search(const NameKey& key) const {
+        auto found = find(key);
+        return {found.begin(), found.end()};
+    }
+
+    /// @brief Поиск без копирования: возвращает представление объектов ключа.
+    ///
+    /// Представление действительно до следующей вставки объекта с этим ключом.
+    /// @param key Искомое имя.
+    /// @return Span найденных объектов или номеров строк (пустой, если ключа нет).
+    std::span<const Value> find(const NameKey& key) const {
+        const Leaf* leaf = findLeaf(key);
+        if (!leaf) return {};
+        return leaf->values;
+    }
+
+    /// @brief Возвращает число различных ключей.
+    size_t keyCount() const { return leaves.size(); }
+
+    /// @brief Возвращает память узлов и листьев в байтах (без содержимого строк и массивов объектов).
+    size_t memoryBytes() const {
+        return node4s.size() * sizeof(Node4) + node16s.size() * sizeof(Node16) +
+               node48s.size() * sizeof(Node48) + node256s.size() * sizeof(Node256) +
+               leaves.size() * sizeof(Leaf);
+    }
+
+    /// @brief Удаляет все узлы и листья дерева.
+    void clear() {
+        node4s.clear();
+        node16s.clear();
+        node48s.clear();
+        node256s.clear();
+        leaves.clear();
+        root = nullptr;
+    }
+
+private:
+    static constexpr size_t kMaxPrefix = 8; ///< Байт сжатого пути, хранимых в узле.
+
+    /// @brief Тип внутреннего узла.
+    enum NodeType : uint8_t { kNode4, kNode16, kNode48, kNode256 };
+
+    /// @brief Лист: полный ключ и все объекты с ним.
+    struct Leaf {
+        NameKey            key;    ///< Ключ (name).
+        std::vector<Value> values; ///< Объекты (номера строк) с данным ключом.
+
+        /// @brief Создаёт лист с первым объектом ключа.
+        Leaf(const NameKey& name, const Value& value) : key(name), values{value} {}
+    };
+
+    /// @brief Общий заголовок внутренних узлов.
+    struct Node {
+        NodeType type;                 ///< Тип узла.
+        uint16_t count{0};             ///< Число потомков.
+        uint32_t prefixLen{0};         ///< Длина сжатого пути перед меткой потомка.
+        uint8_t  prefix[kMaxPrefix]{}; ///< Первые байты сжатого пути.
+        Leaf*    terminal{nullptr};    ///< Лист ключа, заканчивающегося в этом узле.
+
+        explicit Node(NodeType t) : type(t) {}
+    };
+
+    /// @brief Узел до 4 потомков: отсортированные метки.
+    struct Node4 : Node {
+        uint8_t keys[4]{};
+        void*   children[4]{};
+        Node4() : Node(kNode4) {}
+    };
+
+    /// @brief Узел до 16 потомков: отсортированные метки, поиск SSE2.
+    struct Node16 : Node {
+        uint8_t keys[16]{};
+        void*   children[16]{};
+        Node16() : Node(kNode16) {}
+    };
+
+    /// @brief Узел до 48 потомков: index[метка] = номер слота + 1 (0 — нет потомка).
+    struct Node48 : Node {
+        uint8_t index[256]{};
+        void*   children[48]{};
+        Node48() : Node(kNode48) {}
+    };
+
+    /// @brief Узел до 256 потомков: прямой массив по метке.
+    struct Node256 : Node {
+        void* children[256]{};
+        Node256() : Node(kNode256) {}
+    };
+
+    void*                        root{nullptr}; ///< Корень: узел или помеченный лист.
+    NodeArena<Node4>             node4s;        ///< Память Node4.
+    NodeArena<Node16>            node16s;       ///< Память Node16.
+    NodeArena<Node48, 256>       node48s;       ///< Память Node48.
+    NodeArena<Node256, 64>       node256s;      ///< Память Node256.
+    NodeArena<Leaf>              leaves;        ///< Память листьев.
+
+    static bool isLeaf(const void* p) { return reinterpret_cast<uintptr_t>(p) & 1u; }
+    static Leaf* asLeaf(const void* p) {
+        return reinterpret_cast<Leaf*>(reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(1));
+    }
+    static void* tagLeaf(Leaf* leaf) { return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(leaf) | 1u); }
+
+    /// @brief Возвращает адрес указателя на потомка с меткой b или nullptr.
+    static void* const* findChild(const Node* n, uint8_t b) {
+        switch (n->type) {
+        case kNode4: {
+            const auto* n4 = static_cast<const Node4*>(n);
+            for (size_t i = 0; i < n4->count; ++i) {
+                if (n4->keys[i] == b) return &n4->children[i];
+            }
+            return nullptr;
+        }
+        case kNode16: {
+            const auto* n16 = static_cast<const Node16*>(n);
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(n16->keys));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(b)))));
+            mask &= (1u << n16->count) - 1;
+            return mask ? &n16->children[std::countr_zero(mask)] : nullptr;
+#else
+            for (size_t i = 0; i < n16->count; ++i) {
+                if (n16->keys[i] == b) return &n16->children[i];
+            }
+            return nullptr;
+#endif
+        }
+        case kNode48: {
+            const auto* n48 = static_cast<const Node48*>(n);
+            return n48->index[b] ? &n48->children[n48->index[b] - 1] : nullptr;
+        }
+        case kNode256: {
+            const auto* n256 = static_cast<const Node256*>(n);
+            return n256->children[b] ? &n256->children[b] : nullptr;
+        }
+        }
+        return nullptr;
+    }
+
+    /// @brief Спуск по байтам ключа до листа; полный ключ сравнивается только в листе.
+    const Leaf* findLeaf(const NameKey& key) const {
+        const std::string& k = key.str();
+        const void* cur = root;
+        size_t depth = 0;
+        while (cur) {
+            if (isLeaf(cur)) {
+                const Leaf* leaf = asLeaf(cur);
+                return leaf->key == key ? leaf : nullptr;
+            }
+            const auto* n = static_cast<const Node*>(cur);
+            if (n->prefixLen) {
+                if (depth + n->prefixLen > k.size()) return nullptr;
+                const size_t stored = std::min<size_t>(n->prefixLen, kMaxPrefix);
+                if (std::memcmp(n->prefix, k.data() + depth, stored) != 0) return nullptr;
+                depth += n->prefixLen;
+            }
+            if (depth == k.size()) {
+                return n->terminal && n->terminal->key == key ? n->terminal : nullptr;
+            }
+            void* const* child = findChild(n, static_cast<uint8_t>(k[depth]));
+            if (!child) return nullptr;
+            cur = *child;
+            ++depth;
+        }
+        return nullptr;
+    }
+
+    /// @brief Любой лист поддерева: все ключи поддерева совпадают на сжатом пути узла.
+    static const Leaf* anyLeaf(const Node* n) {
+        while (true) {
+            if (n->terminal) return n->terminal;
+            const void* child = nullptr;
+            switch (n->type) {
+            case kNode4:  child = static_cast<const Node4*>(n)->children[0]; break;
+            case kNode16: child = static_cast<const Node16*>(n)->children[0]; break;
+            case kNode48: child = static_cast<const Node48*>(n)->children[0]; break;
+            case kNode256: {
+                const auto* n256 = static_cast<const Node256*>(n);
+                for (size_t b = 0; b < 256 && !child; ++b) child = n256->children[b];
+                break;
+            }
+            }
+            if (isLeaf(child)) return asLeaf(child);
+            n = static_cast<const Node*>(child);
+        }
+    }
+
+    /// @brief Длина совпадения ключа со сжатым путём узла, начиная с позиции depth.
+    static size_t prefixMismatch(const Node* n, const std::string& k, size_t depth) {
+        const size_t stored = std::min<size_t>(n->prefixLen, kMaxPrefix);
+        size_t i = 0;
+        for (; i < stored; ++i) {
+            if (depth + i >= k.size() || static_cast<uint8_t>(k[depth + i]) != n->prefix[i]) return i;
+        }
+        if (n->prefixLen > kMaxPrefix) {
+            const std::string& full = anyLeaf(n)->key.str();
+            for (; i < n->prefixLen; ++i) {
+                if (depth + i >= k.size() || k[depth + i] != full[depth + i]) return i;
+            }
+        }
+        return n->prefixLen;
+    }
+
+    /// @brief Записывает в узел сжатый путь длины len, взятый из key с позиции from.
+    static void setPrefix(Node* n, const std::string& key, size_t from, size_t len) {
+        n->prefixLen = static_cast<uint32_t>(len);
+        std::memcpy(n->prefix, key.data() + from, std::min(len, kMaxPrefix));
+    }
+
+    /// @brief Подвешивает лист к узлу: ключ, закончившийся на depth, становится terminal.
+    void attachLeaf(void** ref, Node* n, Leaf* leaf, size_t depth) {
+        const std::string& k = leaf->key.str();
+        if (depth == k.size()) n->terminal = leaf;
+        else                   addChild(ref, n, static_cast<uint8_t>(k[depth]), tagLeaf(leaf));
+    }
+
+    /// @brief Вставляет лист нового ключа в поддерево *ref, начиная с байта depth.
+    void insertLeaf(void** ref, Leaf* leaf, size_t depth) {
+        const std::string& k = leaf->key.str();
+        while (true) {
+            if (!*ref) {
+                *ref = tagLeaf(leaf);
+                return;
+            }
+            if (isLeaf(*ref)) {
+                // Два листа: новый Node4 с их общим префиксом.
+                Leaf* other = asLeaf(*ref);
+                const std::string& o = other->key.str();
+                size_t lcp = 0;
+                while (depth + lcp < k.size() && depth + lcp < o.size() && k[depth + lcp] == o[depth + lcp]) ++lcp;
+                Node4* n = node4s.create();
+                setPrefix(n, k, depth, lcp);
+                *ref = n;
+                attachLeaf(ref, n, other, depth + lcp);
+                attachLeaf(ref, n, leaf, depth + lcp);
+                return;
+            }
+            auto* n = static_cast<Node*>(*ref);
+            if (n->prefixLen) {
+                const size_t mismatch = prefixMismatch(n, k, depth);
+                if (mismatch < n->prefixLen) {
+                    // Ключ расходится со сжатым путём: путь делится новым Node4.
+                    const std::string& full = anyLeaf(n)->key.str();
+                    Node4* parent = node4s.create();
+                    setPrefix(parent, k, depth, mismatch);
+                    const uint8_t edge = static_cast<uint8_t>(full[depth + mismatch]);
+                    setPrefix(n, full, depth + mismatch + 1, n->prefixLen - mismatch - 1);
+                    *ref = parent;
+                    addChild(ref, parent, edge, n);
+                    attachLeaf(ref, parent, leaf, depth + mismatch);
+                    return;
+                }
+                depth += n->prefixLen;
+            }
+            if (depth == k.size()) {
+                n->terminal = leaf;
+                return;
+            }
+            void* const* child = findChild(n, static_cast<uint8_t>(k[depth]));
+            if (!child) {
+                addChild(ref, n, static_cast<uint8_t>(k[depth]), tagLeaf(leaf));
+                return;
+            }
+            ref = const_cast<void**>(child);
+            ++depth;
+        }
+    }
+
+    /// @brief Вставляет метку b в отсортированный массив меток со сдвигом хвоста.
+    template <size_t N>
+    static void insertSorted(uint8_t (&keys)[N], void* (&children)[N], size_t count, uint8_t b, void* child) {
+        size_t i = 0;
+        while (i < count && keys[i] < b) ++i;
+        std::copy_backward(keys + i, keys + count, keys + count + 1);
+        std::copy_backward(children + i, children + count, children + count + 1);
+        keys[i] = b;
+        children[i] = child;
+    }
+
+    /// @brief Копирует общий заголовок при замене узла более крупным.
+    static void copyHeader(Node* to, const Node* from) {
+        to->count = from->count;
+        to->prefixLen = from->prefixLen;
+        std::memcpy(to->prefix, from->prefix, kMaxPrefix);
+        to->terminal = from->terminal;
+    }
+
+    /// @brief Добавляет потомка с меткой b; полный узел заменяется следующим по размеру (*ref).
+    void addChild(void** ref, Node* n, uint8_t b, void* child) {
+        switch (n->type) {
+        case kNode4: {
+            auto* n4 = static_cast<Node4*>(n);
+            if (n4->count < 4) {
+                insertSorted(n4->keys, n4->children, n4->count++, b, child);
+                return;
+            }
+            Node16* n16 = node16s.create();
+            copyHeader(n16, n4);
+            std::copy_n(n4->keys, 4, n16->keys);
+            std::copy_n(n4->children, 4, n16->children);
+            *ref = n16;
+            node4s.destroy(n4);
+            insertSorted(n16->keys, n16->children, n16->count++, b, child);
+            return;
+        }
+        case kNode16: {
+            auto* n16 = static_cast<Node16*>(n);
+            if (n16->count < 16) {
+                insertSorted(n16->keys, n16->children, n16->count++, b, child);
+                return;
+            }
+            Node48* n48 = node48s.create();
+            copyHeader(n48, n16);
+            for (size_t i = 0; i < 16; ++i) {
+                n48->index[n16->keys[i]] = static_cast<uint8_t>(i + 1);
+                n48->children[i] = n16->children[i];
+            }
+            *ref = n48;
+            node16s.destroy(n16);
+            addChild(ref, n48, b, child);
+            return;
+        }
+        case kNode48: {
+            auto* n48 = static_cast<Node48*>(n);
+            if (n48->count < 48) {
+                // Удаления нет, поэтому слоты заполняются подряд.
+                n48->children[n48->count] = child;
+                n48->index[b] = static_cast<uint8_t>(++n48->count);
+                return;
+            }
+            Node256* n256 = node256s.create();
+            copyHeader(n256, n48);
+            for (size_t c = 0; c < 256; ++c) {
+                if (n48->index[c]) n256->children[c] = n48->children[n48->index[c] - 1];
+            }
+            *ref = n256;
+            node48s.destroy(n48);
+            addChild(ref, n256, b, child);
+            return;
+        }
+        case kNode256: {
+            auto* n256 = static_cast<Node256*>(n);
+            n256->children[b] = child;
+            ++n256->count;
+            return;
+        }
+        }
+    }
+};
+
+/// @brief Статический упорядоченный индекс в неявной раскладке Эйтцингера.
+///
+/// Строится один раз по готовому массиву объектов и дальше не изменяется.
+/// Различные имена лежат в одном плоском массиве в порядке обхода в ширину
+/// идеального дерева поиска (узел k, потомки 2k и 2k+1), поэтому спуск не
+/// разыменовывает указатели, а узлы нескольких следующих уровней подгружаются
+/// заранее через prefetch. Каждому имени соответствует непрерывный диапазон
+/// в массиве номеров строк исходных данных, упорядоченном по имени.
+class StaticSortedIndex {
+public:
+    /// @brief Строит индекс по массиву объектов.
+    /// @param data Исходные объекты; должны жить дольше индекса и не изменяться.
+    explicit StaticSortedIndex(const std::vector<Object>& data) : data(&data) {
+        build(data.size(), [&data](uint32_t row) { return std::string_view(data[row].name.str()); });
+    }
+
+    /// @brief Строит индекс по колоночной таблице; номера строк — строки таблицы.
+    /// @param table Таблица объектов; должна жить дольше индекса и не изменяться.
+    explicit StaticSortedIndex(const ObjectTable& table) : table(&table) {
+        build(table.size(), [&table](uint32_t row) { return table.name(row); });
+    }
+
+    /// @brief Поиск без копирования: номера строк исходных данных с данным именем.
+    /// @param key Искомое имя.
+    /// @return Span номеров строк (пустой, если ключа нет).
+    std::span<const uint32_t> find(const NameKey& key) const {
+        const size_t m = entries.size() - 1;
+        size_t k = 1;
+        while (k <= m) {
+            for (size_t p = 0; p < kPrefetchNodes; ++p) {
+                prefetch(&entries[std::min(kPrefetchNodes * k + p, m)]);
+            }
+            k = 2 * k + static_cast<size_t>(entries[k].key < key);
+        }
+        k >>= std::countr_one(k) + 1; // lower_bound: последний переход влево
+        if (k == 0 || entries[k].key != key) return {};
+        return std::span<const uint32_t>(rows).subspan(entries[k].begin, entries[k].end - entries[k].begin);
+    }
+
+    /// @brief Осуществляет поиск всех объектов с заданным именем.
+    /// @param key Искомое имя.
+    /// @return Вектор найденных объектов.
+    std::vector<Object> search(const NameKey& key) const {
+        std::vector<Object> result;
+        for (uint32_t row : find(key)) result.push_back(data ? (*data)[row] : table->row(row));
+        return result;
+    }
+
+    /// @brief Возвращает число различных ключей в индексе.
+    size_t keyCount() const { return entries.size() - 1; }
+
+private:
+    /// @brief Узел неявного дерева: ключ и диапазон [begin, end) в rows.
+    struct Entry {
+        NameKey     key;    ///< Имя.
+        uint32_t    begin;  ///< Начало диапазона строк.
+        uint32_t    end;    ///< Конец диапазона строк.
+    };
+
+    /// Узлов, подгружаемых заранее: потомки через два уровня (4k..4k+3).
+    static constexpr size_t kPrefetchNodes = 4;
+
+    const std::vector<Object>* data{nullptr};  ///< Исходные объекты (если индекс построен по массиву).
+    const ObjectTable*         table{nullptr}; ///< Исходная таблица (если индекс построен по таблице).
+    std::vector<uint32_t> rows;      ///< Номера строк, упорядоченные по имени.
+    std::vector<Entry>    entries;   ///< Узлы в порядке Эйтцингера (entries[0] не используется).
+
+    /// @brief Упорядочивает строки по имени, группирует их и раскладывает ключи.
+    /// @param count  Число строк.
+    /// @param nameAt Функция вида std::string_view(uint32_t row).
+    template <class NameAt>
+    void build(size_t count, NameAt nameAt) {
+        rows.resize(count);
+        std::iota(rows.begin(), rows.end(), 0u);
+        std::stable_sort(rows.begin(), rows.end(), [&nameAt](uint32_t a, uint32_t b) {
+            return nameAt(a) < nameAt(b);
+        });
+        std::vector<Entry> sorted;
+        for (uint32_t i = 0; i < rows.size(); ++i) {
+            const std::string_view name = nameAt(rows[i]);
+            if (sorted.empty() || sorted.back().key.str() != name) {
+                if (!sorted.empty()) sorted.back().end = i;
+                sorted.push_back({NameKey(std::string(name)), i, i});
+            }
+        }
+        if (!sorted.empty()) sorted.back().end = static_cast<uint32_t>(rows.size());
+        entries.resize(sorted.size() + 1);
+        size_t next = 0;
+        fill(sorted, next, 1);
+    }
+
+    /// @brief Раскладывает отсортированные ключи по порядку Эйтцингера (симметричный обход).
+    /// @param sorted Ключи в порядке возрастания.
+    /// @param next   Номер следующего неразложенного ключа.
+    /// @param k      Текущий узел неявного дерева.
+    void fill(std::vector<Entry>& sorted, size_t& next, size_t k) {
+        if (k >= entries.size()) return;
+        fill(sorted, next, 2 * k);
+        entries[k] = std::move(sorted[next++]);
+        fill(sorted, next, 2 * k + 1);
+    }
+};
+
+/// @brief Класс хеш-таблицы для поиска по строковому ключу с цепочечным разрешением коллизий.
+///
+/// Хеш-функция задаётся политикой HashPolicy (PolynomialHash, Fnv1aHash, WyHash,
+/// PrecomputedHash). Число бакетов — степень двойки, индекс бакета берётся
+/// маской младших битов хеша вместо деления по модулю. При просмотре цепочки
+/// имена сравниваются сначала по хешу NameKey.
+/// @tparam HashPolicy Политика хеширования со статической функцией hash(const NameKey&).
+template <class HashPolicy = PrecomputedHash>
+class HashTable {
+public:
+    /// @brief Конструктор хеш-таблицы.
+    ///
+    /// Когда число объектов превышает maxLoadFactor * bucketCount(), таблица
+    /// удваивается. При incremental = true старые бакеты переносятся постепенно:
+    /// каждая вставка переносит kMigrateStep бакетов, а поиск до конца переноса
+    /// просматривает и старый, и новый массив. При incremental = false весь
+    /// перенос выполняется сразу внутри вставки, вызвавшей рост.
+    /// @param tableSize     Начальное число бакетов (округляется вверх до степени двойки).
+    /// @param maxLoadFactor Максимальное число объектов на бакет.
+    /// @param incremental   Переносить бакеты постепенно.
+    explicit HashTable(size_t tableSize = 16, double maxLoadFactor = 1.0, bool incremental = true)
+            : size(std::bit_ceil(std::max<size_t>(tableSize, 1))), buckets(size), collisionCount(0),
+              maxLoad(maxLoadFactor), incremental(incremental) {}
+
+    /// @brief Вставляет объект в хеш-таблицу.
+    ///
+    /// Если бакет уже не пуст — это коллизия.
+    /// @param obj Объект для вставки.
+    void insert(const Object& obj) {
+        if (static_cast<double>(objects + 1) > maxLoad * static_cast<double>(size)) {
+            startRehash();
+        } else if (rehashing()) {
+            migrate(kMigrateStep);
+        }
+        auto& bucket = buckets[hashFunction(obj.name)];
+        if (!bucket.empty()) {
+            ++collisionCount;
+        }
+        bucket.push_back(obj);
+        ++objects;
+    }
+
+    /// @brief Параллельно строит таблицу по набору объектов, заменяя содержимое.
+    ///
+    /// Число бакетов сразу выбирается так, чтобы рост не понадобился. Построение
+    /// идёт в два прохода без блокировок. Сначала каждый поток хеширует свою
+    /// часть data и считает, сколько объектов попадает в каждую из партиций —
+    /// диапазонов бакетов, заданных старшими битами индекса бакета; по этим
+    /// счётчикам номера объектов раскладываются в общий массив так, что каждая
+    /// партиция занимает в нём непрерывный участок (внутри — в порядке data).
+    /// Затем партиции заполняются параллельно: их бакеты не пересекаются, а
+    /// порядок объектов в бакете совпадает с последовательной вставкой.
+    /// @param data Объекты.
+    /// @param pool Пул потоков.
+    void buildFrom(const std::vector<Object>& data, ThreadPool& pool) {
+        const size_t needed = static_cast<size_t>(std::ceil(static_cast<double>(data.size()) / maxLoad));
+        size = std::max(size, std::bit_ceil(std::max<size_t>(needed, 1)));
+        buckets = std::vector<std::vector<Object>>(size);
+        std::vector<std::vector<Object>>().swap(oldBuckets);
+        migrated = 0;
+
+        const size_t chunks = pool.size();
+        const size_t partitions = std::min(size, std::bit_ceil(chunks * kPartitionsPerThread));
+        const int shift = std::countr_zero(size) - std::countr_zero(partitions);
+        std::vector<uint64_t> hashes(data.size());
+        std::vector<size_t> offsets(chunks * partitions, 0); // [chunk][partition]
+        auto chunkRange = [&](size_t c) {
+            return std::pair<size_t, size_t>(data.size() * c / chunks, data.size() * (c + 1) / chunks);
+        };
+        pool.run(chunks, [&](size_t c) {
+            auto [begin, end] = chunkRange(c);
+            size_t* count = &offsets[c * partitions];
+            for (size_t i = begin; i < end; ++i) {
+                hashes[i] = HashPolicy::hash(data[i].name);
+                ++count[(static_cast<size_t>(hashes[i]) & (size - 1)) >> shift];
+            }
+        });
+        // Счётчики -> начала участков: партиция за партицией, внутри — по частям data.
+        std::vector<size_t> partitionStart(partitions + 1, 0);
+        size_t running = 0;
+        for (size_t part = 0; part < partitions; ++part) {
+            partitionStart[part] = running;
+            for (size_t c = 0; c < chunks; ++c) {
+                const size_t cnt = offsets[c * partitions + part];
+                offsets[c * partitions + part] = running;
+                running += cnt;
+            }
+        }
+        partitionStart[partitions] = running;
+        std::vector<uint32_t> order(data.size());
+        pool.run(chunks, [&](size_t c) {
+            auto [begin, end] = chunkRange(c);
+            size_t* next = &offsets[c * partitions];
+            for (size_t i = begin; i < end; ++i) {
+                order[next[(static_cast<size_t>(hashes[i]) & (size - 1)) >> shift]++] = static_cast<uint32_t>(i);
+            }
+        });
+
+        std::vector<size_t> collisions(partitions, 0);
+        pool.run(partitions, [&](size_t part) {
+            for (size_t k = partitionStart[part]; k < partitionStart[part + 1]; ++k) {
+                const uint32_t row = order[k];
+                auto& bucket = buckets[static_cast<size_t>(hashes[row]) & (size - 1)];
+                if (!bucket.empty()) ++collisions[part];
+                bucket.push_back(data[row]);
+            }
+        });
+        collisionCount = std::accumulate(collisions.begin(), collisions.end(), size_t{0});
+        objects = data.size();
+    }
+
+    /// @brief Осуществляет поиск всех объектов с заданным именем.
+    /// @param key Искомое имя.
+    /// @return Вектор найденных объектов.
+    std::vector<Object> search(const NameKey& key) const {
+        std::vector<Object> result;
+        searchEach(key, [&result](const Object& o) { result.push_back(o); });
+        return result;
+    }
+
+    /// @brief Поиск без копирования: вызывает visit для каждого найденного объекта.
+    ///
+    /// Объекты с разными именами делят бакет, поэтому непрерывного диапазона
+    /// результатов нет — используется обратный вызов.
+    /// @param key   Искомое имя.
+    /// @param visit Функция вида void(const Object&).
+    /// @return Число найденных объектов.
+    template <class Visitor>
+    size_t searchEach(const NameKey& key, Visitor&& visit) const {
+        return scanChains(key, HashPolicy::hash(key), visit);
+    }
+
+    /// @brief Пакетный поиск: сначала хеширует пачку ключей и запрашивает prefetch
+    /// их бакетов, затем просматривает бакеты, которые к этому моменту уже в кэше.
+    /// @param keys  Искомые ключи.
+    /// @param visit Функция вида void(size_t keyIndex, const Object&).
+    /// @return Общее число найденных объектов.
+    template <class Visitor>
+    size_t searchMany(std::span<const NameKey> keys, Visitor&& visit) const {
+        constexpr size_t kBatch = 16;
+        size_t found = 0;
+        uint64_t hashes[kBatch];
+        for (size_t base = 0; base < keys.size(); base += kBatch) {
+            const size_t m = std::min(kBatch, keys.size() - base);
+            for (size_t i = 0; i < m; ++i) {
+                hashes[i] = HashPolicy::hash(keys[base + i]);
+                prefetch(&buckets[hashes[i] & (size - 1)]);
+            }
+            for (size_t i = 0; i < m; ++i) {
+                prefetch(buckets[hashes[i] & (size - 1)].data());
+            }
+            for (size_t i = 0; i < m; ++i) {
+                found += scanChains(keys[base + i], hashes[i],
+                                    [&](const Object& o) { visit(base + i, o); });
+            }
+        }
+        return found;
+    }
+
+    /// @brief Удаляет все объекты с заданным именем.
+    /// @param key Имя.
+    /// @return Число удалённых объектов.
+    size_t erase(const NameKey& key) {
+        size_t removed = 0;
+        forEachChain(HashPolicy::hash(key), [&](std::vector<Object>& bucket) {
+            removed += removeFrom(bucket, [&key](const Object& o) { return o.name == key; }, bucket.size());
+        });
+        return removed;
+    }
+
+    /// @brief Удаляет объект с заданными именем и id.
+    /// @param key Имя.
+    /// @param id  Идентификатор объекта.
+    /// @return true, если объект был найден и удалён.
+    bool erase(const NameKey& key, size_t id) {
+        size_t removed = 0;
+        forEachChain(HashPolicy::hash(key), [&](std::vector<Object>& bucket) {
+            if (removed == 0) {
+                removed = removeFrom(bucket, [&](const Object& o) { return o.id == id && o.name == key; }, 1);
+            }
+        });
+        return removed != 0;
+    }
+
+    /// @brief Изменяет value объекта с заданными именем и id на месте.
+    /// @param key   Имя.
+    /// @param id    Идентификатор объекта.
+    /// @param value Новое значение.
+    /// @return true, если объект был найден.
+    bool updateValue(const NameKey& key, size_t id, double value) {
+        bool updated = false;
+        forEachChain(HashPolicy::hash(key), [&](std::vector<Object>& bucket) {
+            for (auto& o : bucket) {
+                if (!updated && o.id == id && o.name == key) {
+                    o.value = value;
+                    updated = true;
+                }
+            }
+        });
+        return updated;
+    }
+
+    /// @brief Возвращает число коллизий, произошедших при вставке всех элементов.
+    ///
+    /// После переноса бакетов при росте таблицы учитываются коллизии в новом массиве;
+    /// удаление объекта из бакета уменьшает счётчик.
+    /// @return Количество коллизий.
+    size_t getCollisionCount() const {
+        return collisionCount;
+    }
+
+    /// @brief Возвращает число коллизий между различными ключами.
+    ///
+    /// В отличие от getCollisionCount() не учитывает объекты с уже встречавшимся
+    /// в бакете именем: для каждого бакета считается (число различных имён - 1).
+    size_t keyCollisionCount() const {
+        size_t result = 0;
+        forEachBucket([&result](const std::vector<Object>& b) {
+            size_t distinct = 0;
+            for (size_t i = 0; i < b.size(); ++i) {
+                bool seen = false;
+                for (size_t j = 0; j < i && !seen; ++j) seen = b[j].name == b[i].name;
+                if (!seen) ++distinct;
+            }
+            if (distinct > 1) result += distinct - 1;
+        });
+        return result;
+    }
+
+    /// @brief Возвращает длину самой длинной цепочки.
+    size_t maxChainLength() const {
+        size_t longest = 0;
+        forEachBucket([&longest](const std::vector<Object>& b) { longest = std::max(longest, b.size()); });
+        return longest;
+    }
+
+    /// @brief Возвращает число бакетов.
+    size_t bucketCount() const { return size; }
+
+    /// @brief Возвращает число объектов в таблице.
+    size_t objectCount() const { return objects; }
+
+    /// @brief Возвращает true, пока идёт постепенный перенос бакетов.
+    bool rehashing() const { return !oldBuckets.empty(); }
+
+private:
+    /// Число старых бакетов, переносимых за одну вставку. Если порог заполнения
+    /// превышен ещё до конца переноса (maxLoadFactor < 0.25), остаток переносится
+    /// сразу, и таблица снова удваивается (см. startRehash).
+    static constexpr size_t kMigrateStep = 4;
+    /// Партиций на поток при параллельном построении: мелкие партиции
+    /// выравнивают нагрузку, если объекты распределены по ним неравномерно.
+    static constexpr size_t kPartitionsPerThread = 8;
+
+    size_t size;                                 ///< Размер хеш-таблицы (степень двойки).
+    std::vector<std::vector<Object>> buckets;    ///< Бакеты с цепочками.
+    size_t collisionCount;                       ///< Счетчик коллизий.
+    std::vector<std::vector<Object>> oldBuckets; ///< Бакеты до роста (пока идёт перенос).
+    size_t migrated{0};                          ///< Число уже перенесённых старых бакетов.
+    size_t objects{0};                           ///< Число объектов в таблице.
+    double maxLoad;                              ///< Максимальный коэффициент заполнения.
+    bool   incremental;                          ///< Переносить бакеты постепенно.
+
+    /// @brief Индекс бакета ключа: хеш политики, маскированный до числа бакетов.
+    /// @param key Строковый ключ.
+    /// @return Индекс бакета [0..size-1].
+    size_t hashFunction(const NameKey& key) const {
+        return static_cast<size_t>(HashPolicy::hash(key)) & (size - 1);
+    }
+
+    /// @brief Просматривает цепочки ключа: сначала ещё не перенесённый старый бакет
+    /// (там лежат более ранние объекты), затем новый.
+    /// @param key   Искомое имя.
+    /// @param h     Хеш ключа.
+    /// @param visit Функция вида void(const Object&).
+    /// @return Число найденных объектов.
+    template <class Visitor>
+    size_t scanChains(const NameKey& key, uint64_t h, Visitor&& visit) const {
+        size_t found = 0;
+        auto scan = [&](const std::vector<Object>& bucket) {
+            for (const auto& o : bucket) {
+                if (o.name == key) {
+                    visit(o);
+                    ++found;
+                }
+            }
+        };
+        if (rehashing()) {
+            size_t oldIdx = static_cast<size_t>(h) & (oldBuckets.size() - 1);
+            if (oldIdx >= migrated) scan(oldBuckets[oldIdx]);
+        }
+        scan(buckets[static_cast<size_t>(h) & (size - 1)]);
+        return found;
+    }
+
+    /// @brief Вызывает f для цепочек, где может лежать ключ с хешем h: ещё не
+    /// перенесённого старого бакета и нового.
+    /// @param h Хеш ключа.
+    /// @param f Функция вида void(std::vector<Object>&).
+    template <class F>
+    void forEachChain(uint64_t h, F&& f) {
+        if (rehashing()) {
+            size_t oldIdx = static_cast<size_t>(h) & (oldBuckets.size() - 1);
+            if (oldIdx >= migrated) f(oldBuckets[oldIdx]);
+        }
+        f(buckets[static_cast<size_t>(h) & (size - 1)]);
+    }
+
+    /// @brief Удаляет из бакета до limit объектов, удовлетворяющих pred, сохраняя
+    /// порядок остальных; поддерживает счётчики объектов и коллизий.
+    ///
+    /// Опустевший бакет отдаёт память, а бакет, занимающий менее четверти своей
+    /// ёмкости, ужимается, чтобы удаления действительно освобождали память.
+    /// @param bucket Цепочка.
+    /// @param pred   Условие удаления.
+    /// @param limit  Максимальное число удаляемых объектов.
+    /// @return Число удалённых объектов.
+    template <class Pred>
+    size_t removeFrom(std::vector<Object>& bucket, Pred&& pred, size_t limit) {
+        const size_t before = bucket.size();
+        size_t removed = 0;
+        auto out = bucket.begin();
+        for (auto it = bucket.begin(); it != bucket.end(); ++it) {
+            if (removed < limit && pred(*it)) {
+                ++removed;
+                continue;
+            }
+            if (out != it) *out = std::move(*it);
+            ++out;
+        }
+        if (removed == 0) return 0;
+        bucket.erase(out, bucket.end());
+        // Непустой бакет из s объектов даёт s - 1 коллизию.
+        collisionCount -= (before - 1) - (bucket.empty() ? 0 : bucket.size() - 1);
+        objects -= removed;
+        if (bucket.empty()) {
+            std::vector<Object>().swap(bucket);
+        } else if (bucket.size() * 4 < bucket.capacity()) {
+            bucket.shrink_to_fit();
+        }
+        return removed;
+    }
+
+    /// @brief Вызывает f для каждого непустого бакета (старого и нового массива).
+    template <class F>
+    void forEachBucket(F&& f) const {
+        for (size_t i = migrated; i < oldBuckets.size(); ++i) f(oldBuckets[i]);
+        for (const auto& b : buckets) f(b);
+    }
+
+    /// @brief Начинает рост: текущие бакеты становятся старыми, выделяется вдвое больший массив.
+    void startRehash() {
+        if (rehashing()) migrate(oldBuckets.size());
+        oldBuckets = std::move(buckets);
+        migrated = 0;
+        size *= 2;
+        buckets = std::vector<std::vector<Object>>(size);
+        if (!incremental) migrate(oldBuckets.size());
+    }
+
+    /// @brief Переносит до count старых бакетов в новый массив.
+    ///
+    /// Перенесённые объекты ставятся в начало нового бакета, чтобы сохранить
+    /// порядок вставки относительно объектов, добавленных во время переноса.
+    /// @param count Максимальное число переносимых бакетов.
+    void migrate(size_t count) {
+        const size_t end = std::min(oldBuckets.size(), migrated + count);
+        for (; migrated < end; ++migrated) {
+            auto& from = oldBuckets[migrated];
+            if (from.empty()) continue;
+            collisionCount -= from.size() - 1;
+            // Старый бакет i делится между новыми бакетами i и i + старый размер;
+            // pos — куда вставлять следующий перенесённый объект в каждом из них.
+            size_t pos[2] = {0, 0};
+            for (auto& o : from) {
+                const size_t idx = hashFunction(o.name);
+                auto& to = buckets[idx];
+                size_t& p = pos[idx == migrated ? 0 : 1];
+                if (!to.empty()) ++collisionCount;
+                if (p == to.size()) to.push_back(std::move(o));
+                else                to.insert(to.begin() + static_cast<std::ptrdiff_t>(p), std::move(o));
+                ++p;
+            }
+            std::vector<Object>().swap(from);
+        }
+        if (migrated == oldBuckets.size()) {
+            std::vector<std::vector<Object>>().swap(oldBuckets);
+            migrated = 0;
+        }
+    }
+};
+
+/// @brief Потокобезопасная хеш-таблица с цепочками: блокировки по полосам для
+/// писателей и читатели без блокировок.
+///
+/// Бакет — односвязный список неизменяемых узлов. Писатель берёт мьютекс своей
+/// полосы (бакеты с одинаковым индексом по модулю числа полос), полностью создаёт
+/// узел и публикует его в конец цепочки одной release-записью указателя.
+/// Читатель проходит цепочку acquire-чтениями без блокировок и ожиданий: он видит
+/// либо старый конец цепочки, либо полностью построенный новый узел. Удаления нет,
+/// поэтому узлы живут до разрушения таблицы и освобождать их при чтении не нужно.
+/// Число бакетов фиксировано при создании.
+/// @tparam HashPolicy Политика хеширования (как у HashTable).
+template <class HashPolicy = PrecomputedHash>
+class ConcurrentHashTable {
+public:
+    /// @brief Конструктор.
+    /// @param tableSize Число бакетов (округляется вверх до степени двойки).
+    /// @param stripes   Число полос блокировок (округляется вверх до степени двойки).
+    explicit ConcurrentHashTable(size_t tableSize, size_t stripes = 64)
+            : size(std::bit_ceil(std::max<size_t>(tableSize, 1))),
+              heads(new std::atomic<Node*>[size]),
+              locks(std::bit_ceil(std::max<size_t>(stripes, 1))) {
+        for (size_t i = 0; i < size; ++i) heads[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    ~ConcurrentHashTable() {
+        for (size_t i = 0; i < size; ++i) {
+            Node* n = heads[i].load(std::memory_order_relaxed);
+            while (n) {
+                Node* next = n->next.load(std::memory_order_relaxed);
+                delete n;
+                n = next;
+            }
+        }
+    }
+
+    /// @brief Вставляет объект (потокобезопасно).
+    ///
+    /// Если бакет уже не пуст — это коллизия.
+    /// @param obj Объект для вставки.
+    void insert(const Object& obj) {
+        const size_t idx = hashFunction(obj.name);
+        Node* node = new Node(obj);
+        std::lock_guard<std::mutex> lock(locks[idx & (locks.size() - 1)].mutex);
+        std::atomic<Node*>* link = &heads[idx];
+        Node* cur = link->load(std::memory_order_relaxed);
+        if (cur) {
+            collisionCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        while (cur) {
+            link = &cur->next;
+            cur = link->load(std::memory_order_relaxed);
+        }
+        link->store(node, std::memory_order_release);
+    }
+
+    /// @brief Поиск без блокировок: вызывает visit для каждого найденного объекта.
+    /// @param key   Искомое имя.
+    /// @param visit Функция вида void(const Object&).
+    /// @return Число найденных объектов.
+    template <class Visitor>
+    size_t searchEach(const NameKey& key, Visitor&& visit) const {
+        size_t found = 0;
+        for (const Node* n = heads[hashFunction(key)].load(std::memory_order_acquire); n;
+             n = n->next.load(std::memory_order_acquire)) {
+            if (n->obj.name == key) {
+                visit(n->obj);
+                ++found;
+            }
+        }
+        return found;
+    }
+
+    /// @brief Осуществляет поиск всех объектов с заданным именем.
+    /// @param key Искомое имя.
+    /// @return Вектор найденных объектов.
+    std::vector<Object> search(const NameKey& key) const {
+        std::vector<Object> result;
+        searchEach(key, [&result](const Object& o) { result.push_back(o); });
+        return result;
+    }
+
+    /// @brief Возвращает число коллизий, произошедших при вставке.
+    size_t getCollisionCount() const {
+        return collisionCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// @brief Узел цепочки; после публикации меняется только поле next последнего узла.
+    struct Node {
+        Object             obj;           ///< Объект.
+        std::atomic<Node*> next{nullptr}; ///< Следующий узел цепочки.
+
+        /// @brief Конструктор узла.
+        explicit Node(const Object& o) : obj(o) {}
+    };
+
+    /// @brief Мьютекс полосы, выровненный по строке кэша против ложного разделения.
+    struct alignas(64) Stripe {
+        std::mutex mutex; ///< Мьютекс полосы.
+    };
+
+    size_t size;                                  ///< Число бакетов (степень двойки).
+    std::unique_ptr<std::atomic<Node*>[]> heads;  ///< Головы цепочек.
+    std::vector<Stripe> locks;                    ///< Полосы блокировок.
+    std::atomic<size_t> collisionCount{0};        ///< Счетчик коллизий.
 
-    /// @brief Рекурсивно удаляет все узлы.
-    /// @param n Корень поддерева.
-    void clear(Node* n) {
-        if (!n) return;
-        clear(n->left);
-        clear(n->right);
-        delete n;
+    /// @brief Индекс бакета ключа.
+    size_t hashFunction(const NameKey& key) const {
+        return static_cast<size_t>(HashPolicy::hash(key)) & (size - 1);
     }
 };
 
-/// @brief Класс хеш-таблицы для поиска по строковому ключу с цепочечным разрешением коллизий.
+/// @brief Хеш-таблица с открытой адресацией в стиле Swiss table.
 ///
-/// Использует полиномиальный роллинг-хеш и вектор бакетов.
-class HashTable {
+/// Все слоты лежат в одном плоском массиве, рядом хранится массив управляющих байтов
+/// (по одному на слот): 0x80 — слот пуст, 0..127 — слот занят, значение равно
+/// младшим 7 битам хеша (H2). Поиск сравнивает H2 сразу с группой из kGroupWidth
+/// управляющих байтов (SSE2 — 16, AVX2 — 32) и только для совпавших слотов сравнивает
+/// строки. Пробирование — треугольное по группам. Объекты с одинаковым именем
+/// хранятся в одном слоте.
+/// @tparam Value Полезная нагрузка: Object (копия объекта) или uint32_t (номер
+///               строки ObjectTable).
+template <class Value = Object>
+class FlatHashTable {
 public:
+#if defined(__AVX2__)
+    static constexpr size_t kGroupWidth = 32; ///< Число слотов, проверяемых за один шаг.
+#else
+    static constexpr size_t kGroupWidth = 16; ///< Число слотов, проверяемых за один шаг.
+#endif
+
     /// @brief Конструктор хеш-таблицы.
-    /// @param tableSize Число бакетов (размер массива бакетов).
-    explicit HashTable(size_t tableSize)
-            : size(tableSize), buckets(tableSize), collisionCount(0) {}
+    /// @param expectedKeys Ожидаемое число различных ключей (для начальной ёмкости).
+    explicit FlatHashTable(size_t expectedKeys = 0) {
+        size_t cap = kGroupWidth;
+        while (cap * 7 / 8 < expectedKeys) cap *= 2;
+        allocate(cap);
+    }
 
     /// @brief Вставляет объект в хеш-таблицу.
-    ///
-    /// Если бакет уже не пуст — это коллизия.
     /// @param obj Объект для вставки.
-    void insert(const Object& obj) {
-        size_t idx = hashFunction(obj.name);
-        if (!buckets[idx].empty()) {
-            ++collisionCount;
+    void insert(const Object& obj) { insert(obj.name, obj); }
+
+    /// @brief Вставляет полезную нагрузку по ключу.
+    ///
+    /// Если ключ уже есть — значение добавляется в слот этого ключа.
+    /// @param key   Ключ (name).
+    /// @param value Объект или номер строки.
+    void insert(const NameKey& key, const Value& value) {
+        size_t h = hashFunction(key);
+        size_t slot = findSlot(key, h);
+        if (slot != npos) {
+            slots[slot].values.push_back(value);
+            return;
         }
-        buckets[idx].push_back(obj);
+        if ((count + 1) * 8 > capacity * 7) {
+            grow();
+        }
+        slot = findEmpty(h);
+        ctrl[slot] = static_cast<int8_t>(h & 0x7F);
+        slots[slot].key = key;
+        slots[slot].values.push_back(value);
+        ++count;
     }
 
     /// @brief Осуществляет поиск всех объектов с заданным именем.
     /// @param key Искомое имя.
     /// @return Вектор найденных объектов.
-    std::vector<Object> search(const std::string& key) const {
-        size_t idx = hashFunction(key);
-        std::vector<Object> result;
-        for (const auto& o : buckets[idx]) {
-            if (o.name == key) {
-                result.push_back(o);
+    std::vector<Object> search(const NameKey& key) const {
+        auto found = find(key);
+        return {found.begin(), found.end()};
+    }
+
+    /// @brief Поиск без копирования: возвращает представление объектов слота.
+    ///
+    /// Представление действительно до следующей вставки.
+    /// @param key Искомое имя.
+    /// @return Span найденных значений (пустой, если ключа нет).
+    std::span<const Value> find(const NameKey& key) const {
+        size_t slot = findSlot(key, hashFunction(key));
+        if (slot == npos) return {};
+        return slots[slot].values;
+    }
+
+    /// @brief Пакетный поиск: хеширует пачку ключей, запрашивает prefetch групп
+    /// управляющих байтов, затем выполняет обычное пробирование.
+    /// @param keys  Искомые ключи.
+    /// @param visit Функция вида void(size_t keyIndex, const Value&).
+    /// @return Общее число найденных значений.
+    template <class Visitor>
+    size_t searchMany(std::span<const NameKey> keys, Visitor&& visit) const {
+        constexpr size_t kBatch = 16;
+        const size_t groups = capacity / kGroupWidth;
+        size_t found = 0;
+        size_t hashes[kBatch];
+        for (size_t base = 0; base < keys.size(); base += kBatch) {
+            const size_t m = std::min(kBatch, keys.size() - base);
+            for (size_t i = 0; i < m; ++i) {
+                hashes[i] = hashFunction(keys[base + i]);
+                prefetch(ctrl.data() + ((hashes[i] >> 7) & (groups - 1)) * kGroupWidth);
+            }
+            for (size_t i = 0; i < m; ++i) {
+                size_t slot = findSlot(keys[base + i], hashes[i]);
+                if (slot == npos) continue;
+                for (const auto& value : slots[slot].values) visit(base + i, value);
+                found += slots[slot].values.size();
             }
         }
-        return result;
+        return found;
     }
 
-    /// @brief Возвращает число коллизий, произошедших при вставке всех элементов.
-    /// @return Количество коллизий.
-    size_t getCollisionCount() const {
-        return collisionCount;
-    }
+    /// @brief Возвращает число различных ключей в таблице.
+    size_t keyCount() const { return count; }
 
 private:
-    size_t size;                             ///< Размер хеш-таблицы.
-    std::vector<std::vector<Object>> buckets;///< Бакеты с цепочками.
-    size_t collisionCount;                   ///< Счетчик коллизий.
+    static constexpr int8_t kEmpty = static_cast<int8_t>(0x80); ///< Маркер пустого слота.
+    static constexpr size_t npos = static_cast<size_t>(-1);     ///< «Слот не найден».
 
-    /// @brief Собственная хеш-функция (полиномиальный роллинг-хеш).
-    /// @param key Строковый ключ.
-    /// @return Индекс бакета [0..size-1].
-    size_t hashFunction(const std::string& key) const {
-        unsigned long h = 0;
-        const unsigned long P = 131;
-        for (unsigned char c : key) {
-            h = (h * P + c) % size;
+    /// @brief Слот таблицы: ключ и все значения с этим ключом.
+    struct Slot {
+        NameKey            key;    ///< Ключ (name).
+        std::vector<Value> values; ///< Все объекты (или номера строк) с данным ключом.
+    };
+
+    std::vector<int8_t> ctrl;  ///< Управляющие байты (по одному на слот).
+    std::vector<Slot>   slots; ///< Слоты таблицы.
+    size_t capacity{0};        ///< Число слотов (степень двойки, кратна kGroupWidth).
+    size_t count{0};           ///< Число занятых слотов.
+
+    /// @brief Выделяет пустую таблицу заданной ёмкости.
+    /// @param cap Новая ёмкость.
+    void allocate(size_t cap) {
+        capacity = cap;
+        count = 0;
+        ctrl.assign(cap, kEmpty);
+        slots.clear();
+        slots.resize(cap);
+    }
+
+    /// @brief Хеш-функция ключа (заранее вычисленный хеш NameKey).
+    static size_t hashFunction(const NameKey& key) {
+        return static_cast<size_t>(key.hash());
+    }
+
+    /// @brief Возвращает битовую маску слотов группы, управляющий байт которых равен b.
+    /// @param group Указатель на первый управляющий байт группы.
+    /// @param b     Искомое значение.
+    static uint32_t matchByte(const int8_t* group, int8_t b) {
+#if defined(__AVX2__)
+        __m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(g, _mm256_set1_epi8(b))));
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(b))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            if (group[i] == b) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    /// @brief Ищет слот с заданным ключом.
+    /// @param key Ключ.
+    /// @param h   Хеш ключа.
+    /// @return Индекс слота или npos.
+    size_t findSlot(const NameKey& key, size_t h) const {
+        const size_t groups = capacity / kGroupWidth;
+        const int8_t h2 = static_cast<int8_t>(h & 0x7F);
+        size_t g = (h >> 7) & (groups - 1);
+        for (size_t step = 1; ; ++step) {
+            const int8_t* group = ctrl.data() + g * kGroupWidth;
+            for (uint32_t m = matchByte(group, h2); m; m &= m - 1) {
+                size_t slot = g * kGroupWidth + static_cast<size_t>(std::countr_zero(m));
+                if (slots[slot].key == key) return slot;
+            }
+            if (matchByte(group, kEmpty)) return npos;
+            if (step > groups) return npos;
+            g = (g + step) & (groups - 1);
+        }
+    }
+
+    /// @brief Находит первый пустой слот на пути пробирования хеша h.
+    size_t findEmpty(size_t h) const {
+        const size_t groups = capacity / kGroupWidth;
+        size_t g = (h >> 7) & (groups - 1);
+        for (size_t step = 1; ; ++step) {
+            uint32_t m = matchByte(ctrl.data() + g * kGroupWidth, kEmpty);
+            if (m) return g * kGroupWidth + static_cast<size_t>(std::countr_zero(m));
+            g = (g + step) & (groups - 1);
+        }
+    }
+
+    /// @brief Увеличивает ёмкость вдвое и перераспределяет слоты.
+    void grow() {
+        std::vector<int8_t> oldCtrl  = std::move(ctrl);
+        std::vector<Slot>   oldSlots = std::move(slots);
+        allocate(capacity * 2);
+        for (size_t i = 0; i < oldSlots.size(); ++i) {
+            if (oldCtrl[i] == kEmpty) continue;
+            size_t h = hashFunction(oldSlots[i].key);
+            size_t slot = findEmpty(h);
+            ctrl[slot] = static_cast<int8_t>(h & 0x7F);
+            slots[slot] = std::move(oldSlots[i]);
+            ++count;
         }
-        return h;
     }
 };
 
@@ -394,99 +3747,1338 @@ std::vector<Object> multimapSearch(const std::multimap<std::string, Object>& mma
     return result;
 }
 
-int main() {
-    setlocale(LC_ALL, "ru_RU.UTF-8");
+/// @brief Поиск в std::multimap без копирования результатов.
+/// @param mmap  Стандартный multimap<name, Object>.
+/// @param key   Искомое имя.
+/// @param visit Функция вида void(const Object&).
+/// @return Число найденных объектов.
+template <class Visitor>
+size_t multimapSearchEach(const std::multimap<std::string, Object>& mmap,
+                          const std::string& key, Visitor&& visit) {
+    size_t found = 0;
+    auto range = mmap.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        visit(it->second);
+        ++found;
+    }
+    return found;
+}
+
+/// @brief Пакетный поиск в std::multimap (последовательные equal_range).
+/// @param mmap  Стандартный multimap<name, Object>.
+/// @param keys  Искомые ключи.
+/// @param visit Функция вида void(size_t keyIndex, const Object&).
+/// @return Общее число найденных объектов.
+template <class Visitor>
+size_t multimapSearchMany(const std::multimap<std::string, Object>& mmap,
+                          std::span<const NameKey> keys, Visitor&& visit) {
+    size_t found = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        found += multimapSearchEach(mmap, keys[i], [&](const Object& o) { visit(i, o); });
+    }
+    return found;
+}
+
+/// @brief Блочный фильтр Блума для отсечения отсутствующих ключей перед индексом.
+///
+/// Фильтр разбит на блоки по 256 бит (8 слов по 32 бита, выровнены по 32 байтам,
+/// так что блок целиком лежит в одной кэш-линии). Старшая половина хеша ключа
+/// (NameKey::hash) выбирает блок, младшая с восемью «солями» — по одному биту в
+/// каждом слове блока. Проверка ключа читает одну кэш-линию и выполняет восемь
+/// независимых операций над словами без ветвлений, что компилятор раскладывает
+/// в векторные инструкции. Ложноотрицательных ответов нет; доля ложноположительных
+/// при 10 битах на ключ — около 1%.
+class BloomFilter {
+public:
+    static constexpr size_t kWords = 8; ///< 32-битных слов в блоке.
+
+    /// @brief Создаёт пустой фильтр.
+    /// @param expectedKeys Ожидаемое число различных ключей.
+    /// @param bitsPerKey   Бит фильтра на ключ.
+    explicit BloomFilter(size_t expectedKeys = 0, double bitsPerKey = 10.0) {
+        const double bits = static_cast<double>(std::max<size_t>(expectedKeys, 1)) * bitsPerKey;
+        blocks.resize(std::max<size_t>(static_cast<size_t>(std::ceil(bits / (kWords * 32))), 1));
+    }
+
+    /// @brief Добавляет ключ.
+    /// @param key Ключ.
+    void insert(const NameKey& key) {
+        Block& block = blockFor(key.hash());
+        const uint32_t h = static_cast<uint32_t>(key.hash());
+        for (size_t i = 0; i < kWords; ++i) block.words[i] |= bitFor(h, i);
+    }
+
+    /// @brief Добавляет имена всех объектов.
+    /// @param data Объекты.
+    void buildFrom(const std::vector<Object>& data) {
+        for (const auto& obj : data) insert(obj.name);
+    }
+
+    /// @brief Проверяет, может ли ключ присутствовать.
+    /// @param key Ключ.
+    /// @return false — ключа точно нет; true — ключ, возможно, есть.
+    bool mayContain(const NameKey& key) const {
+        const Block& block = blocks[blockIndex(key.hash())];
+        const uint32_t h = static_cast<uint32_t>(key.hash());
+        uint32_t missing = 0;
+        for (size_t i = 0; i < kWords; ++i) missing |= bitFor(h, i) & ~block.words[i];
+        return missing == 0;
+    }
+
+    /// @brief Возвращает объём фильтра в байтах.
+    size_t memoryBytes() const { return blocks.size() * sizeof(Block); }
+
+private:
+    /// @brief Блок фильтра (256 бит).
+    struct alignas(32) Block {
+        uint32_t words[kWords] = {};
+    };
+
+    /// @brief Нечётные множители, задающие номер бита в каждом слове блока.
+    static constexpr uint32_t kSalt[kWords] = {
+            0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+            0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    /// @brief Номер блока ключа: старшие 32 бита хеша, приведённые к числу блоков умножением.
+    size_t blockIndex(uint64_t hash) const {
+        return static_cast<size_t>(((hash >> 32) * static_cast<uint64_t>(blocks.size())) >> 32);
+    }
+
+    Block& blockFor(uint64_t hash) { return blocks[blockIndex(hash)]; }
+
+    /// @brief Бит ключа в слове i: старшие 5 бит произведения младшей половины хеша на соль.
+    static uint32_t bitFor(uint32_t h, size_t i) {
+        return 1u << ((h * kSalt[i]) >> 27);
+    }
+
+    std::vector<Block> blocks; ///< Блоки фильтра.
+};
+
+/// @brief Поиск за фильтром Блума: lookup(key) вызывается, только если фильтр не отверг ключ.
+/// @param filter Фильтр, содержащий все ключи индекса.
+/// @param key    Искомый ключ.
+/// @param lookup Функция вида size_t(const NameKey&) — поиск в самом индексе.
+/// @return Результат lookup или 0, если ключа точно нет.
+template <class Lookup>
+size_t bloomGuarded(const BloomFilter& filter, const NameKey& key, Lookup&& lookup) {
+    return filter.mayContain(key) ? lookup(key) : 0;
+}
+
+/// @brief Измеряет время выполнения функции.
+/// @param f Измеряемая функция.
+/// @return Время в наносекундах.
+template <class F>
+long long measureNs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+}
+
+/// @brief Статистика распределения времени одной операции (в наносекундах).
+struct LatencyStats {
+    double mean{0};   ///< Среднее.
+    double stddev{0}; ///< Стандартное отклонение.
+    long long p50{0}; ///< Медиана.
+    long long p90{0}; ///< 90-й перцентиль.
+    long long p99{0}; ///< 99-й перцентиль.
+    long long p999{0}; ///< 99.9-й перцентиль.
+    long long max{0}; ///< Максимум.
+};
+
+/// @brief Вычисляет статистику по набору замеров.
+/// @param samples Замеры в наносекундах (сортируются на месте).
+/// @return Статистика распределения.
+LatencyStats computeStats(std::vector<long long>& samples) {
+    LatencyStats st;
+    if (samples.empty()) return st;
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (long long x : samples) sum += static_cast<double>(x);
+    st.mean = sum / static_cast<double>(samples.size());
+    double sq = 0;
+    for (long long x : samples) sq += (static_cast<double>(x) - st.mean) * (static_cast<double>(x) - st.mean);
+    st.stddev = std::sqrt(sq / static_cast<double>(samples.size()));
+    auto pct = [&samples](double q) {
+        size_t idx = static_cast<size_t>(q * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[idx];
+    };
+    st.p50 = pct(0.50);
+    st.p90 = pct(0.90);
+    st.p99 = pct(0.99);
+    st.p999 = pct(0.999);
+    st.max = samples.back();
+    return st;
+}
+
+/// @brief Оценивает накладные расходы пары вызовов таймера (медиана пустых замеров).
+/// @return Накладные расходы в наносекундах.
+long long timerOverheadNs() {
+    std::vector<long long> samples(1000);
+    for (auto& x : samples) x = measureNs([] {});
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+/// @brief Замеряет время отдельных поисков по набору ключей.
+///
+/// Сначала выполняется warmup прогревочных поисков (не замеряются), затем каждый
+/// из первых count ключей ищется отдельно со своим замером; из замера вычитаются
+/// накладные расходы таймера.
+/// @param keys     Ключи поиска.
+/// @param count    Число замеряемых поисков (не больше keys.size()).
+/// @param warmup   Число прогревочных поисков.
+/// @param overhead Накладные расходы таймера (нс).
+/// @param op       Функция вида void(const NameKey&).
+/// @return Статистика времени одного поиска.
+template <class F>
+LatencyStats benchmarkLookups(const std::vector<NameKey>& keys, size_t count, size_t warmup,
+                              long long overhead, F&& op) {
+    count = std::min(count, keys.size());
+    for (size_t i = 0; i < warmup && count > 0; ++i) {
+        op(keys[i % count]);
+    }
+    std::vector<long long> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = std::max(measureNs([&] { op(keys[i]); }) - overhead, 0LL);
+    }
+    return computeStats(samples);
+}
+
+/// @brief Таблица CSV, столбцы которой задаются по ходу заполнения первой строки.
+class CsvTable {
+public:
+    /// @brief Открывает файл для записи.
+    /// @param path Путь к CSV-файлу.
+    explicit CsvTable(const std::string& path) : out(path) {}
+
+    /// @brief Добавляет значение столбца в текущую строку.
+    /// @param column Имя столбца (используется только в первой строке).
+    /// @param value  Значение.
+    template <class T>
+    CsvTable& add(const std::string& column, const T& value) {
+        if (!headerWritten) columns.push_back(column);
+        std::ostringstream ss;
+        ss << value;
+        values.push_back(ss.str());
+        return *this;
+    }
+
+    /// @brief Добавляет столбцы со статистикой: prefix_p50, prefix_p90, prefix_p99, prefix_p999, prefix_max, prefix_std.
+    /// @param prefix Префикс имён столбцов.
+    /// @param st     Статистика.
+    CsvTable& addStats(const std::string& prefix, const LatencyStats& st) {
+        add(prefix + "_p50", st.p50);
+        add(prefix + "_p90", st.p90);
+        add(prefix + "_p99", st.p99);
+        add(prefix + "_p999", st.p999);
+        add(prefix + "_max", st.max);
+        add(prefix + "_std", static_cast<long long>(st.stddev));
+        return *this;
+    }
+
+    /// @brief Записывает текущую строку (перед первой — заголовок).
+    void endRow() {
+        if (!headerWritten) {
+            writeLine(columns);
+            headerWritten = true;
+        }
+        writeLine(values);
+        values.clear();
+    }
+
+private:
+    std::ofstream out;                ///< Выходной файл.
+    std::vector<std::string> columns; ///< Имена столбцов.
+    std::vector<std::string> values;  ///< Значения текущей строки.
+    bool headerWritten{false};        ///< Заголовок уже записан.
+
+    /// @brief Записывает строку значений через запятую.
+    void writeLine(const std::vector<std::string>& cells) {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            out << (i ? "," : "") << cells[i];
+        }
+        out << '\n';
+    }
+};
+
+/// @brief Привязывает текущий поток к одному ядру на время своей жизни.
+///
+/// При отрицательном номере ядра ничего не делает. В деструкторе восстанавливает
+/// прежнюю маску привязки (потоки пула, созданные после привязки, её наследуют).
+class ScopedCpuPin {
+public:
+    /// @brief Привязывает поток к ядру cpu.
+    /// @param cpu Номер ядра или -1.
+    explicit ScopedCpuPin(int cpu) {
+        if (cpu < 0) return;
 #ifdef _WIN32
-    SetConsoleCP(65001);
-    SetConsoleOutputCP(65001);
+        previous = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+        pinned = previous != 0;
+#elif defined(__linux__)
+        if (pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) == 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pinned = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+        }
+#endif
+        if (!pinned) std::cerr << "Не удалось привязать поток к ядру " << cpu << "\n";
+    }
+
+    ScopedCpuPin(const ScopedCpuPin&) = delete;
+    ScopedCpuPin& operator=(const ScopedCpuPin&) = delete;
+
+    ~ScopedCpuPin() {
+        if (!pinned) return;
+#ifdef _WIN32
+        SetThreadAffinityMask(GetCurrentThread(), previous);
+#elif defined(__linux__)
+        pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+#endif
+    }
+
+private:
+    bool pinned{false}; ///< Привязка выполнена.
+#ifdef _WIN32
+    DWORD_PTR previous{0}; ///< Прежняя маска.
+#elif defined(__linux__)
+    cpu_set_t previous{};  ///< Прежняя маска.
 #endif
-    /// @brief Список размеров массива для тестирования.
-    std::vector<size_t> testSizes = {
+};
+
+/// @brief Параметры запуска бенчмарка, задаваемые из командной строки.
+struct BenchmarkConfig {
+    /// @brief --sizes: размеры массивов для тестирования.
+    std::vector<size_t> sizes = {
             100, 50000, 100000,
             200000, 300000, 400000, 500000, 600000, 750000, 1000000
     };
+    size_t threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1); ///< --threads: максимум потоков.
+    size_t warmup        = 200;  ///< --warmup: прогревочных поисков на структуру.
+    size_t lookups       = 5000; ///< --lookups: замеряемых поисков на структуру.
+    size_t linearLookups = 50;   ///< --linear-lookups: замеряемых поисков для линейных сканов.
+    /// @brief Нагрузка: --cardinality, --key-length, --popularity, --zipf-theta, --hot-keys,
+    /// --hot-access, --miss-ratio (ключи поиска — в режимах search и workload).
+    WorkloadSpec workload;
+    int    pinCpu        = -1;   ///< --pin: ядро для привязки замеряющего потока (-1 — без привязки).
+    uint64_t    seed     = std::random_device{}(); ///< --seed: зерно генерации данных и выбора ключей.
+    std::string mode     = "search"; ///< --mode: search, hash, growth, concurrent, snapshot, churn, range, workload.
+};
+
+/// @brief Разбирает список чисел через запятую.
+/// @param text Строка вида "100,5000,10000".
+/// @return Вектор чисел.
+std::vector<size_t> parseSizeList(const std::string& text) {
+    std::vector<size_t> result;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) result.push_back(std::stoul(item));
+    }
+    return result;
+}
+
+/// @brief Разбирает аргументы командной строки.
+/// @param argc Число аргументов.
+/// @param argv Аргументы.
+/// @return Конфигурация бенчмарка.
+BenchmarkConfig parseArgs(int argc, char* argv[]) {
+    BenchmarkConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--threads" && hasValue) {
+            cfg.threads = std::max<size_t>(std::stoul(argv[++i]), 1);
+        } else if (arg == "--sizes" && hasValue) {
+            cfg.sizes = parseSizeList(argv[++i]);
+        } else if (arg == "--warmup" && hasValue) {
+            cfg.warmup = std::stoul(argv[++i]);
+        } else if (arg == "--lookups" && hasValue) {
+            cfg.lookups = std::max<size_t>(std::stoul(argv[++i]), 1);
+        } else if (arg == "--linear-lookups" && hasValue) {
+            cfg.linearLookups = std::max<size_t>(std::stoul(argv[++i]), 1);
+        } else if (arg == "--miss-ratio" && hasValue) {
+            cfg.workload.missRatio = std::clamp(std::stod(argv[++i]), 0.0, 1.0);
+        } else if (arg == "--cardinality" && hasValue) {
+            cfg.workload.keys.cardinality = std::stoul(argv[++i]);
+        } else if (arg == "--key-length" && hasValue) {
+            const std::string range = argv[++i];
+            const size_t dash = range.find('-');
+            cfg.workload.keys.minLength = std::stoul(range.substr(0, dash));
+            cfg.workload.keys.maxLength = dash == std::string::npos ? cfg.workload.keys.minLength
+                                                                    : std::stoul(range.substr(dash + 1));
+        } else if (arg == "--popularity" && hasValue) {
+            const std::string_view name = argv[++i];
+            cfg.workload.popularity = name == "zipf"    ? Popularity::Zipf
+                                    : name == "hotspot" ? Popularity::Hotspot
+                                                        : Popularity::Uniform;
+        } else if (arg == "--zipf-theta" && hasValue) {
+            cfg.workload.zipfTheta = std::stod(argv[++i]);
+        } else if (arg == "--hot-keys" && hasValue) {
+            cfg.workload.hotKeys = std::clamp(std::stod(argv[++i]), 0.0, 1.0);
+        } else if (arg == "--hot-access" && hasValue) {
+            cfg.workload.hotAccess = std::clamp(std::stod(argv[++i]), 0.0, 1.0);
+        } else if (arg == "--pin" && hasValue) {
+            cfg.pinCpu = std::stoi(argv[++i]);
+        } else if (arg == "--mode" && hasValue) {
+            cfg.mode = argv[++i];
+        } else if (arg == "--seed" && hasValue) {
+            cfg.seed = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "Неизвестный аргумент: " << arg << "\n"
+                      << "Использование: " << argv[0]
+                      << " [--sizes N1,N2,...] [--threads N] [--warmup N] [--lookups N]"
+                         " [--linear-lookups N] [--pin CPU] [--seed N]"
+                         " [--mode search|hash|growth|concurrent|snapshot|churn|range|workload]\n"
+                         "       [--cardinality N] [--key-length MIN[-MAX]] [--popularity uniform|zipf|hotspot]"
+                         " [--zipf-theta T] [--hot-keys F] [--hot-access F] [--miss-ratio R]\n";
+            std::exit(1);
+        }
+    }
+    return cfg;
+}
+
+/// @brief Генерирует данные размера n по параметрам cfg и печатает время генерации.
+/// @param n   Число объектов.
+/// @param cfg Параметры бенчмарка (зерно, число потоков и пространство имён).
+/// @return Вектор сгенерированных объектов.
+std::vector<Object> generateForBenchmark(size_t n, const BenchmarkConfig& cfg) {
+    std::vector<Object> data;
+    const long long ns = measureNs([&] { data = generateData(n, cfg.seed, cfg.threads, cfg.workload.keys); });
+    std::cout << "Генерация данных размера " << n << ": " << ns / 1000 << " мкс\n";
+    return data;
+}
+
+/// @brief Выбирает случайные ключи поиска из имён объектов.
+/// @param data  Объекты.
+/// @param count Число ключей.
+/// @return Вектор ключей.
+std::vector<NameKey> sampleKeys(const std::vector<Object>& data, size_t count) {
+    std::uniform_int_distribution<size_t> idxDist(0, data.size() - 1);
+    std::vector<NameKey> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        keys.push_back(data[idxDist(rng)].name);
+    }
+    return keys;
+}
+
+/// @brief Замеряет одну политику хеширования: скорость хеша, построение, коллизии и поиск.
+/// @tparam Policy   Политика хеширования HashTable.
+/// @param out      Таблица результатов.
+/// @param data     Объекты.
+/// @param keys     Ключи поиска.
+/// @param cfg      Параметры бенчмарка.
+/// @param overhead Накладные расходы таймера.
+template <class Policy>
+void benchmarkHashPolicy(CsvTable& out, const std::vector<Object>& data, const std::vector<NameKey>& keys,
+                         const BenchmarkConfig& cfg, long long overhead) {
+    size_t bytes = 0;
+    for (const auto& o : data) bytes += o.name.size();
+    uint64_t acc = 0;
+    long long hashNs = measureNs([&] { for (const auto& o : data) acc ^= Policy::hash(o.name); });
+    volatile uint64_t sink = acc;
+    (void)sink;
+
+    HashTable<Policy> table(data.size());
+    long long build = measureNs([&] { for (const auto& o : data) table.insert(o); });
+    size_t matched = 0;
+    LatencyStats lookup = benchmarkLookups(keys, cfg.lookups, cfg.warmup, overhead, [&](const NameKey& k) {
+        table.searchEach(k, [&matched](const Object&) { ++matched; });
+    });
+    volatile size_t matchedSink = matched;
+    (void)matchedSink;
+
+    const double nsPerKey = static_cast<double>(hashNs) / static_cast<double>(std::max<size_t>(data.size(), 1));
+    const double mbps = static_cast<double>(bytes) * 1e3 / static_cast<double>(std::max(hashNs, 1LL));
+    out.add("Size", data.size())
+       .add("Policy", Policy::name)
+       .add("HashNsPerKey", nsPerKey)
+       .add("HashMBps", mbps)
+       .add("Build", build)
+       .add("Collisions", table.getCollisionCount())
+       .add("KeyCollisions", table.keyCollisionCount())
+       .add("MaxChain", table.maxChainLength())
+       .add("Lookup", static_cast<long long>(lookup.mean))
+       .add("Lookup_p99", lookup.p99);
+    out.endRow();
+    std::cout << "  " << Policy::name << ": " << nsPerKey << " нс/ключ, " << mbps << " МБ/с, coll="
+              << table.getCollisionCount() << " keyColl=" << table.keyCollisionCount() << " maxChain=" << table.maxChainLength()
+              << " lookup=" << static_cast<long long>(lookup.mean) << " нс\n";
+}
+
+/// @brief Режим --mode hash: сравнение политик хеширования HashTable (hash_results.csv).
+/// @param cfg      Параметры бенчмарка.
+/// @param overhead Накладные расходы таймера.
+void runHashBenchmark(const BenchmarkConfig& cfg, long long overhead) {
+    CsvTable out("hash_results.csv");
+    for (size_t n : cfg.sizes) {
+        auto data = generateForBenchmark(n, cfg);
+        auto keys = sampleKeys(data, cfg.lookups);
+        ScopedCpuPin pin(cfg.pinCpu);
+        benchmarkHashPolicy<PolynomialHash>(out, data, keys, cfg, overhead);
+        benchmarkHashPolicy<Fnv1aHash>(out, data, keys, cfg, overhead);
+        benchmarkHashPolicy<WyHash>(out, data, keys, cfg, overhead);
+        benchmarkHashPolicy<PrecomputedHash>(out, data, keys, cfg, overhead);
+    }
+}
+
+/// @brief Режим --mode growth: задержка вставки в HashTable, растущую с 16 бакетов (growth_results.csv).
+///
+/// Сравнивает постепенный перенос бакетов с переносом целиком в момент роста.
+/// @param cfg      Параметры бенчмарка.
+/// @param overhead Накладные расходы таймера.
+void runGrowthBenchmark(const BenchmarkConfig& cfg, long long overhead) {
+    CsvTable out("growth_results.csv");
+    for (size_t n : cfg.sizes) {
+        auto data = generateForBenchmark(n, cfg);
+        ScopedCpuPin pin(cfg.pinCpu);
+        for (bool incremental : {true, false}) {
+            HashTable<> table(16, 1.0, incremental);
+            std::vector<long long> samples(data.size());
+            long long total = measureNs([&] {
+                for (size_t i = 0; i < data.size(); ++i) {
+                    samples[i] = std::max(measureNs([&] { table.insert(data[i]); }) - overhead, 0LL);
+                }
+            });
+            LatencyStats st = computeStats(samples);
+            const char* mode = incremental ? "Incremental" : "StopTheWorld";
+            out.add("Size", n)
+               .add("Rehash", mode)
+               .add("Total", total)
+               .add("Mean", static_cast<long long>(st.mean))
+               .add("p50", st.p50)
+               .add("p90", st.p90)
+               .add("p99", st.p99)
+               .add("p999", st.p999)
+               .add("Max", st.max)
+               .add("Buckets", table.bucketCount());
+            out.endRow();
+            std::cout << "  " << mode << ": p50=" << st.p50 << " p99=" << st.p99 << " p99.9=" << st.p999
+                      << " max=" << st.max << " нс, всего " << total / 1000000 << " мс\n";
+        }
+    }
+}
+
+/// @brief Режим --mode churn: удаления и вставки при постоянном размере (churn_results.csv).
+///
+/// Генерируется последовательность из --lookups шагов «удалить случайный живой
+/// объект по (name, id), вставить новый». Каждый индекс проигрывает её со
+/// своим замером на шаг; для сравнения замеряется полная перестройка индекса по
+/// итоговому набору объектов и обновление value на месте.
+/// @param cfg      Параметры бенчмарка.
+/// @param overhead Накладные расходы таймера (нс).
+void runChurnBenchmark(const BenchmarkConfig& cfg, long long overhead) {
+    CsvTable out("churn_results.csv");
+    for (size_t n : cfg.sizes) {
+        auto data = generateForBenchmark(n, cfg);
+        const size_t steps = std::max<size_t>(cfg.lookups, 1);
+        // Новые имена — из того же пространства имён, что и данные (--cardinality, --key-length).
+        const KeySpace& keys = cfg.workload.keys;
+        const BoundedDistribution nameDist(keys.count(n));
+        std::uniform_real_distribution<double> valDist(0.0, 100.0);
+
+        std::vector<Object> live = data, victims, arrivals;
+        victims.reserve(steps);
+        arrivals.reserve(steps);
+        for (size_t i = 0; i < steps; ++i) {
+            const size_t idx = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+            victims.push_back(live[idx]);
+            arrivals.emplace_back(n + 1 + i, keys.name(nameDist(rng)), valDist(rng));
+            live[idx] = arrivals.back();
+        }
+
+        ScopedCpuPin pin(cfg.pinCpu);
+        out.add("Size", n).add("Steps", steps);
+        auto measure = [&](const char* name, auto& index) {
+            for (const auto& o : data) index.insert(o);
+            std::vector<long long> samples(steps);
+            for (size_t i = 0; i < steps; ++i) {
+                samples[i] = std::max(measureNs([&] {
+                    index.erase(victims[i].name, victims[i].id);
+                    index.insert(arrivals[i]);
+                }) - overhead, 0LL);
+            }
+            LatencyStats churn = computeStats(samples);
+            for (size_t i = 0; i < steps; ++i) {
+                const Object& o = live[i % live.size()];
+                samples[i] = std::max(measureNs([&] { index.updateValue(o.name, o.id, o.value + 1); }) - overhead, 0LL);
+            }
+            LatencyStats update = computeStats(samples);
+            using Index = std::remove_reference_t<decltype(index)>;
+            long long rebuild = measureNs([&] {
+                Index fresh;
+                for (const auto& o : live) fresh.insert(o);
+            });
+            out.add(std::string("Churn_") + name, static_cast<long long>(churn.mean))
+               .addStats(std::string("Churn_") + name, churn)
+               .add(std::string("Update_") + name, static_cast<long long>(update.mean))
+               .add(std::string("Rebuild_") + name, rebuild);
+            std::cout << "  " << name << ": удаление+вставка " << static_cast<long long>(churn.mean)
+                      << " нс (p99 " << churn.p99 << "), обновление " << static_cast<long long>(update.mean)
+                      << " нс, перестройка " << rebuild / 1000 << " мкс\n";
+        };
+        {
+            BinarySearchTree bst;
+            measure("BST", bst);
+        }
+        {
+            RedBlackTree rbt;
+            measure("RBT", rbt);
+            out.add("Nodes_RBT", rbt.nodeCount());
+        }
+        {
+            HashTable<> hashTable;
+            measure("Hash", hashTable);
+        }
+        out.endRow();
+    }
+}
+
+/// @brief Прогоняет смешанную нагрузку чтение/запись в threads потоках.
+///
+/// Поток i выполняет opsPerThread операций: с вероятностью readRatio — поиск
+/// случайного ключа, иначе — вставку следующего объекта из своей доли inserts.
+/// @param threads      Число потоков.
+/// @param opsPerThread Операций на поток.
+/// @param readRatio    Доля чтений.
+/// @param keys         Ключи для чтений.
+/// @param inserts      Объекты для вставок.
+/// @param read         Функция вида void(const NameKey&).
+/// @param write        Функция вида void(const Object&).
+/// @return Пропускная способность, операций в секунду.
+template <class Read, class Write>
+double runMixedWorkload(size_t threads, size_t opsPerThread, double readRatio,
+                        const std::vector<NameKey>& keys, const std::vector<Object>& inserts,
+                        Read&& read, Write&& write) {
+    std::atomic<bool> go{false};
+    std::atomic<size_t> ready{0};
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::mt19937_64 local(t + 1);
+            std::uniform_real_distribution<double> coin(0.0, 1.0);
+            std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+            const size_t begin = inserts.size() * t / threads;
+            const size_t end   = inserts.size() * (t + 1) / threads;
+            size_t next = begin;
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (size_t i = 0; i < opsPerThread; ++i) {
+                if (coin(local) < readRatio || next == end) read(keys[pick(local)]);
+                else                                        write(inserts[next++]);
+            }
+        });
+    }
+    while (ready.load() < threads) std::this_thread::yield();
+    long long ns = measureNs([&] {
+        go.store(true, std::memory_order_release);
+        for (auto& th : pool) th.join();
+    });
+    return static_cast<double>(threads * opsPerThread) * 1e9 / static_cast<double>(std::max(ns, 1LL));
+}
+
+/// @brief Режим --mode concurrent: смешанная нагрузка на общую таблицу (concurrent_results.csv).
+///
+/// Сравнивает ConcurrentHashTable с HashTable под одним общим мьютексом
+/// для 1..cfg.threads потоков и нескольких долей чтений.
+/// @param cfg Параметры бенчмарка.
+void runConcurrentBenchmark(const BenchmarkConfig& cfg) {
+    CsvTable out("concurrent_results.csv");
+    for (size_t n : cfg.sizes) {
+        auto data = generateForBenchmark(n, cfg);
+        // Первая половина данных загружается заранее, вторая — вставляется во время замера.
+        const std::vector<Object> preload(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(n / 2));
+        const std::vector<Object> inserts(data.begin() + static_cast<std::ptrdiff_t>(n / 2), data.end());
+        auto keys = sampleKeys(data, std::max<size_t>(cfg.lookups, 1));
+        const size_t opsPerThread = std::max<size_t>(n, 1000);
+
+        for (double readRatio : {0.5, 0.9, 0.99}) {
+            for (size_t t = 1; t <= cfg.threads; ++t) {
+                size_t matched = 0;
+                ConcurrentHashTable<> concurrent(n);
+                for (const auto& o : preload) concurrent.insert(o);
+                double lockFree = runMixedWorkload(t, opsPerThread, readRatio, keys, inserts,
+                        [&](const NameKey& k) { concurrent.searchEach(k, [](const Object&) {}); },
+                        [&](const Object& o) { concurrent.insert(o); });
+
+                std::mutex globalLock;
+                HashTable<> locked(n);
+                for (const auto& o : preload) locked.insert(o);
+                double global = runMixedWorkload(t, opsPerThread, readRatio, keys, inserts,
+                        [&](const NameKey& k) {
+                            std::lock_guard<std::mutex> lock(globalLock);
+                            matched += locked.searchEach(k, [](const Object&) {});
+                        },
+                        [&](const Object& o) {
+                            std::lock_guard<std::mutex> lock(globalLock);
+                            locked.insert(o);
+                        });
+                volatile size_t sink = matched;
+                (void)sink;
+
+                out.add("Size", n)
+                   .add("Threads", t)
+                   .add("ReadRatio", readRatio)
+                   .add("Striped_Ops", static_cast<long long>(lockFree))
+                   .add("GlobalLock_Ops", static_cast<long long>(global))
+                   .add("Collisions", concurrent.getCollisionCount());
+                out.endRow();
+                std::cout << "  reads=" << readRatio << " threads=" << t
+                          << ": striped=" << static_cast<long long>(lockFree)
+                          << " global lock=" << static_cast<long long>(global) << " оп/с\n";
+            }
+        }
+    }
+}
+
+/// @brief Результат замера «читатели + писатель».
+struct ReadWriteThroughput {
+    double reads{0};  ///< Поисков в секунду (все читатели вместе).
+    double writes{0}; ///< Вставок в секунду.
+};
+
+/// @brief Запускает readers потоков поиска и, по желанию, один поток вставки.
+///
+/// Каждый читатель выполняет readsPerReader поисков случайных ключей; писатель
+/// вставляет объекты из inserts, пока читатели не закончат.
+/// @param readers        Число потоков-читателей.
+/// @param readsPerReader Поисков на читателя.
+/// @param withWriter     Запускать ли писателя.
+/// @param keys           Ключи для поиска.
+/// @param inserts        Объекты для вставки.
+/// @param read           Функция вида size_t(const NameKey&): число найденных объектов.
+/// @param write          Функция вида void(const Object&).
+/// @return Пропускная способность читателей и писателя.
+template <class Read, class Write>
+ReadWriteThroughput runReadersWithWriter(size_t readers, size_t readsPerReader, bool withWriter,
+                                         const std::vector<NameKey>& keys, const std::vector<Object>& inserts,
+                                         Read&& read, Write&& write) {
+    std::atomic<bool> go{false}, readersDone{false};
+    std::atomic<size_t> ready{0}, written{0}, matched{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < readers; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937_64 local(t + 1);
+            std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            size_t found = 0;
+            for (size_t i = 0; i < readsPerReader; ++i) found += read(keys[pick(local)]);
+            matched.fetch_add(found, std::memory_order_relaxed);
+        });
+    }
+    std::thread writer;
+    if (withWriter) {
+        writer = std::thread([&] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            size_t i = 0;
+            for (; i < inserts.size() && !readersDone.load(std::memory_order_relaxed); ++i) write(inserts[i]);
+            written.store(i);
+        });
+    }
+    while (ready.load() < readers + (withWriter ? 1 : 0)) std::this_thread::yield();
+    long long ns = measureNs([&] {
+        go.store(true, std::memory_order_release);
+        for (auto& th : threads) th.join();
+    });
+    readersDone.store(true);
+    if (writer.joinable()) writer.join();
+    volatile size_t sink = matched.load();
+    (void)sink;
+    const double sec = static_cast<double>(std::max(ns, 1LL)) / 1e9;
+    return {static_cast<double>(readers * readsPerReader) / sec, static_cast<double>(written.load()) / sec};
+}
 
-    std::ofstream resultFile("search_results.csv");
-    resultFile << "Size,Linear,BST,RBT,Hash,Multimap,Collisions\n";
+/// @brief Режим --mode snapshot: читатели RedBlackTree во время вставок (snapshot_results.csv).
+///
+/// Сравнивает PersistentRedBlackTree (снимки без блокировок) с RedBlackTree
+/// под std::shared_mutex, без писателя и с одним параллельным писателем.
+/// @param cfg Параметры бенчмарка.
+void runSnapshotBenchmark(const BenchmarkConfig& cfg) {
+    CsvTable out("snapshot_results.csv");
+    for (size_t n : cfg.sizes) {
+        auto data = generateForBenchmark(n, cfg);
+        const std::vector<Object> preload(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(n / 2));
+        const std::vector<Object> inserts(data.begin() + static_cast<std::ptrdiff_t>(n / 2), data.end());
+        auto keys = sampleKeys(data, std::max<size_t>(cfg.lookups, 1));
+        const size_t readsPerReader = std::max<size_t>(n, 1000);
+
+        for (size_t readers = 1; readers <= cfg.threads; ++readers) {
+            for (bool withWriter : {false, true}) {
+                PersistentRedBlackTree cow;
+                for (const auto& o : preload) cow.insert(o);
+                auto cowResult = runReadersWithWriter(readers, readsPerReader, withWriter, keys, inserts,
+                        [&](const NameKey& k) { return cow.snapshot().find(k).size(); },
+                        [&](const Object& o) { cow.insert(o); });
+
+                std::shared_mutex rw;
+                RedBlackTree locked;
+                for (const auto& o : preload) locked.insert(o);
+                auto rwResult = runReadersWithWriter(readers, readsPerReader, withWriter, keys, inserts,
+                        [&](const NameKey& k) {
+                            std::shared_lock<std::shared_mutex> lock(rw);
+                            return locked.find(k).size();
+                        },
+                        [&](const Object& o) {
+                            std::unique_lock<std::shared_mutex> lock(rw);
+                            locked.insert(o);
+                        });
+                out.add("Size", n)
+                   .add("Readers", readers)
+                   .add("Writer", withWriter ? 1 : 0)
+                   .add("COW_Reads", static_cast<long long>(cowResult.reads))
+                   .add("COW_Writes", static_cast<long long>(cowResult.writes))
+                   .add("RWLock_Reads", static_cast<long long>(rwResult.reads))
+                   .add("RWLock_Writes", static_cast<long long>(rwResult.writes))
+                   .add("COW_PendingReclaim", cow.pendingReclaim());
+                out.endRow();
+                std::cout << "  readers=" << readers << (withWriter ? " + writer" : "          ")
+                          << ": COW reads=" << static_cast<long long>(cowResult.reads)
+                          << " writes=" << static_cast<long long>(cowResult.writes)
+                          << " | RW-lock reads=" << static_cast<long long>(rwResult.reads)
+                          << " writes=" << static_cast<long long>(rwResult.writes) << " оп/с\n";
+            }
+        }
+    }
+}
+
+/// @brief Режим --mode range: диапазонные и префиксные запросы (range_results.csv).
+///
+/// Сравнивает RedBlackTree::rangeEach / prefixEach с полным линейным проходом.
+/// Диапазон — от случайного имени до имени, стоящего на kRangeKeys различных
+/// имён дальше; префикс — случайное имя без двух последних символов.
+/// @param cfg Параметры бенчмарка.
+void runRangeBenchmark(const BenchmarkConfig& cfg) {
+    constexpr size_t kRangeKeys = 100;
+    CsvTable out("range_results.csv");
+    for (size_t n : cfg.sizes) {
+        auto data = generateForBenchmark(n, cfg);
+        RedBlackTree rbt;
+        for (const auto& o : data) rbt.insert(o);
+
+        std::vector<NameKey> names;
+        for (auto it = rbt.begin(); it != rbt.end(); ++it) names.push_back(it->key);
+        const size_t queries = std::max<size_t>(cfg.lookups, 1);
+        std::vector<std::pair<NameKey, NameKey>> ranges;
+        std::vector<NameKey> prefixes;
+        std::uniform_int_distribution<size_t> pick(0, names.size() - 1);
+        for (size_t q = 0; q < queries; ++q) {
+            const size_t i = pick(rng);
+            ranges.emplace_back(names[i], names[std::min(i + kRangeKeys, names.size() - 1)]);
+            const std::string& name = names[pick(rng)].str();
+            prefixes.emplace_back(name.substr(0, name.size() > 2 ? name.size() - 2 : name.size()));
+        }
+
+        size_t matched = 0;
+        auto count = [&matched](const Object&) { ++matched; };
+        auto linearRange = [&](const NameKey& from, const NameKey& to) {
+            for (const auto& o : data) {
+                if (!(o.name < from) && o.name < to) count(o);
+            }
+        };
+        auto linearPrefix = [&](const NameKey& prefix) {
+            for (const auto& o : data) {
+                if (o.name.str().starts_with(prefix.str())) count(o);
+            }
+        };
+        // Среднее время запроса (нс) по первым cnt запросам.
+        auto perQuery = [](size_t cnt, auto&& op) {
+            long long ns = measureNs([&] { for (size_t q = 0; q < cnt; ++q) op(q); });
+            return static_cast<long long>(static_cast<double>(ns) / static_cast<double>(std::max<size_t>(cnt, 1)));
+        };
+
+        ScopedCpuPin pin(cfg.pinCpu);
+        const size_t linQueries = std::min(cfg.linearLookups, queries);
+        size_t before = matched;
+        long long rangeRBT = perQuery(queries, [&](size_t q) { rbt.rangeEach(ranges[q].first, ranges[q].second, count); });
+        const double rangeHits = static_cast<double>(matched - before) / static_cast<double>(queries);
+        long long rangeLin = perQuery(linQueries, [&](size_t q) { linearRange(ranges[q].first, ranges[q].second); });
+        before = matched;
+        long long prefixRBT = perQuery(queries, [&](size_t q) { rbt.prefixEach(prefixes[q], count); });
+        const double prefixHits = static_cast<double>(matched - before) / static_cast<double>(queries);
+        long long prefixLin = perQuery(linQueries, [&](size_t q) { linearPrefix(prefixes[q]); });
+        volatile size_t sink = matched;
+        (void)sink;
+
+        out.add("Size", n)
+           .add("Range_RBT", rangeRBT)
+           .add("Range_Linear", rangeLin)
+           .add("Range_Hits", rangeHits)
+           .add("Prefix_RBT", prefixRBT)
+           .add("Prefix_Linear", prefixLin)
+           .add("Prefix_Hits", prefixHits);
+        out.endRow();
+        std::cout << "  диапазон (~" << static_cast<long long>(rangeHits) << " объектов): RBT=" << rangeRBT
+                  << " нс, линейно=" << rangeLin << " нс; префикс (~" << static_cast<long long>(prefixHits)
+                  << " объектов): RBT=" << prefixRBT << " нс, линейно=" << prefixLin << " нс\n";
+    }
+}
+
+/// @brief Режим workload: поиск во всех структурах при разных длинах ключей и популярности (workload_results.csv).
+///
+/// Для каждого размера и каждой длины имён из kKeyLengths генерируется набор
+/// данных, затем каждая структура строится по очереди (чтобы в памяти была одна) и
+/// замеряется на одних и тех же потоках ключей для равномерной, ципфовской и
+/// «горячей» популярности. Число различных имён, перекос и доля промахов берутся
+/// из cfg.workload. Строка CSV — одна пара (нагрузка, структура); для каждой
+/// нагрузки печатается самая быстрая структура, что показывает точки пересечения.
+/// @param cfg      Параметры бенчмарка.
+/// @param overhead Накладные расходы таймера.
+void runWorkloadBenchmark(const BenchmarkConfig& cfg, long long overhead) {
+    static constexpr size_t kKeyLengths[] = {0, 16, 32, 64, 128}; // 0 — имена "Name<number>"
+    static constexpr Popularity kPopularities[] = {Popularity::Uniform, Popularity::Zipf, Popularity::Hotspot};
+    constexpr size_t kLoads = std::size(kPopularities);
+    CsvTable out("workload_results.csv");
+
+    for (size_t n : cfg.sizes) {
+        for (size_t keyLength : kKeyLengths) {
+            BenchmarkConfig point = cfg;
+            point.workload.keys.minLength = point.workload.keys.maxLength = keyLength;
+            auto data = generateForBenchmark(n, point);
+
+            std::vector<std::vector<NameKey>> keys;
+            size_t cardinality = 0;
+            double avgKeyLength = 0;
+            for (Popularity popularity : kPopularities) {
+                WorkloadSpec spec = point.workload;
+                spec.popularity = popularity;
+                const Workload workload(data, spec);
+                keys.push_back(workload.keys(cfg.lookups, rng));
+                cardinality = workload.cardinality();
+                avgKeyLength = workload.averageKeyLength();
+            }
+
+            size_t matched = 0;
+            auto count = [&matched](const Object&) { ++matched; };
+            std::array<std::pair<const char*, double>, kLoads> best;
+            best.fill({"", std::numeric_limits<double>::infinity()});
+            ScopedCpuPin pin(cfg.pinCpu);
+            auto measure = [&](const char* engine, size_t lookups, auto&& op) {
+                for (size_t p = 0; p < kLoads; ++p) {
+                    const LatencyStats st = benchmarkLookups(keys[p], lookups, std::min(cfg.warmup, lookups), overhead, op);
+                    out.add("Size", n)
+                       .add("KeyLength", avgKeyLength)
+                       .add("Cardinality", cardinality)
+                       .add("Popularity", popularityName(kPopularities[p]))
+                       .add("MissRatio", cfg.workload.missRatio)
+                       .add("Engine", engine)
+                       .add("Mean", static_cast<long long>(st.mean))
+                       .addStats("Lookup", st);
+                    out.endRow();
+                    if (st.mean < best[p].second) best[p] = {engine, st.mean};
+                }
+            };
+
+            const size_t linLookups = std::min(cfg.linearLookups, cfg.lookups);
+            {
+                ObjectTable table(data);
+                measure("LinearSIMD", linLookups, [&](const NameKey& k) {
+                    linearSearchSimd(table, k, [&matched](size_t) { ++matched; });
+                });
+            }
+            {
+                BinarySearchTree bst;
+                bst.buildFrom(data);
+                measure("BST", cfg.lookups, [&](const NameKey& k) { matched += bst.find(k).size(); });
+            }
+            {
+                RedBlackTree rbt;
+                rbt.buildFrom(data);
+                measure("RBT", cfg.lookups, [&](const NameKey& k) { matched += rbt.find(k).size(); });
+            }
+            {
+                BPlusTree bplus;
+                for (const auto& o : data) bplus.insert(o);
+                measure("BPlus", cfg.lookups, [&](const NameKey& k) { matched += bplus.find(k).size(); });
+            }
+            {
+                AdaptiveRadixTree art;
+                for (const auto& o : data) art.insert(o);
+                measure("ART", cfg.lookups, [&](const NameKey& k) { matched += art.find(k).size(); });
+            }
+            {
+                StaticSortedIndex index(data);
+                measure("StaticIndex", cfg.lookups, [&](const NameKey& k) { matched += index.find(k).size(); });
+            }
+            {
+                HashTable hashTable(data.size());
+                for (const auto& o : data) hashTable.insert(o);
+                measure("Hash", cfg.lookups, [&](const NameKey& k) { hashTable.searchEach(k, count); });
+            }
+            {
+                FlatHashTable flatHash(cardinality);
+                for (const auto& o : data) flatHash.insert(o);
+                measure("FlatHash", cfg.lookups, [&](const NameKey& k) { matched += flatHash.find(k).size(); });
+            }
+            {
+                std::multimap<std::string, Object> mmap;
+                for (const auto& o : data) mmap.insert({o.name, o});
+                measure("Multimap", cfg.lookups, [&](const NameKey& k) { multimapSearchEach(mmap, k, count); });
+            }
+            volatile size_t sink = matched;
+            (void)sink;
+
+            std::cout << "  длина ключа ~" << static_cast<long long>(avgKeyLength) << ", различных " << cardinality
+                      << ": быстрее всех —";
+            for (size_t p = 0; p < kLoads; ++p) {
+                std::cout << " " << popularityName(kPopularities[p]) << ": " << best[p].first
+                          << " (" << static_cast<long long>(best[p].second) << " нс)";
+            }
+            std::cout << "\n";
+        }
+    }
+}
 
-    std::uniform_int_distribution<size_t> idxDist;
+/// @brief Основной режим: сравнение всех структур поиска (search_results.csv, scaling_results.csv).
+/// @param cfg      Параметры бенчмарка.
+/// @param overhead Накладные расходы таймера.
+void runSearchBenchmark(const BenchmarkConfig& cfg, long long overhead) {
+    CsvTable resultFile("search_results.csv");
+    CsvTable scalingFile("scaling_results.csv");
 
-    for (size_t n : testSizes) {
-        std::cout << "Генерация данных размера " << n << "...\n";
-        auto data = generateData(n);
+    for (size_t n : cfg.sizes) {
+        auto data = generateForBenchmark(n, cfg);
+
+        const Workload workload(data, cfg.workload);
+        std::vector<NameKey> searchKeys = workload.keys(cfg.lookups, rng);
+        const size_t linLookups = std::min(cfg.linearLookups, cfg.lookups);
+        const size_t linWarmup  = std::min(cfg.warmup, linLookups);
+
+        size_t matched = 0; // не даёт компилятору выбросить «пустые» обходы
+        auto count = [&matched](const Object&) { ++matched; };
 
         BinarySearchTree bst;
         RedBlackTree      rbt;
+        BPlusTree         bplus;
+        AdaptiveRadixTree art;
         HashTable         hashTable(data.size());
+        FlatHashTable     flatHash(workload.cardinality());
         std::multimap<std::string, Object> mmap;
-        for (const auto& o : data) {
-            bst.insert(o);
-            rbt.insert(o);
-            hashTable.insert(o);
-            mmap.insert({o.name, o});
-        }
-        size_t collisions = hashTable.getCollisionCount();
-
-        idxDist = std::uniform_int_distribution<size_t>(0, data.size() - 1);
-
-        std::vector<std::string> searchKeys;
-        for (int i = 0; i < 10; ++i) {
-            searchKeys.push_back(data[idxDist(rng)].name);
-        }
-
-        long long sumLin = 0, sumBST = 0, sumRBT = 0, sumHash = 0, sumMM = 0;
-        for (const auto& key : searchKeys) {
-            auto t0 = std::chrono::high_resolution_clock::now();
-            auto r1 = linearSearch(data, key);
-            auto t1 = std::chrono::high_resolution_clock::now();
-            sumLin += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
-
-            t0 = std::chrono::high_resolution_clock::now();
-            auto r2 = bst.search(key);
-            t1 = std::chrono::high_resolution_clock::now();
-            sumBST += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
-
-            t0 = std::chrono::high_resolution_clock::now();
-            auto r3 = rbt.search(key);
-            t1 = std::chrono::high_resolution_clock::now();
-            sumRBT += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
-
-            t0 = std::chrono::high_resolution_clock::now();
-            auto r4 = hashTable.search(key);
-            t1 = std::chrono::high_resolution_clock::now();
-            sumHash += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
-
-            t0 = std::chrono::high_resolution_clock::now();
-            auto r5 = multimapSearch(mmap, key);
-            t1 = std::chrono::high_resolution_clock::now();
-            sumMM += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
-        }
-
-        long long avgLin  = sumLin  / static_cast<long long>(searchKeys.size());
-        long long avgBST  = sumBST  / static_cast<long long>(searchKeys.size());
-        long long avgRBT  = sumRBT  / static_cast<long long>(searchKeys.size());
-        long long avgHash = sumHash / static_cast<long long>(searchKeys.size());
-        long long avgMM   = sumMM   / static_cast<long long>(searchKeys.size());
-
-        resultFile
-                << n << ','
-                << avgLin  << ','
-                << avgBST  << ','
-                << avgRBT  << ','
-                << avgHash << ','
-                << avgMM   << ','
-                << collisions
-                << '\n';
+        std::optional<StaticSortedIndex> staticIndex;
+        ObjectTable table;
+
+        LatencyStats linBloom, rbtBloom, hashBloom;
+        LatencyStats lin, linView, linSoA, linSimd, bstSt, bstView, rbtSt, rbtView, bplusSt, bplusView, artSt, artView, staticSt,
+                     hashSt, hashView, flatSt, flatView, mmSt, mmView;
+        long long buildBST, buildRBT, buildBPlus, buildART, buildStatic, buildHash, buildFlat, buildMM, destroyBST, destroyRBT;
+        long long buildTable, buildBloom;
+        std::optional<BloomFilter> bloom;
+        long long bulkBST, bulkRBT;
+        // Те же индексы с номером строки ObjectTable вместо копии объекта.
+        LatencyStats bstRows, rbtRows, bplusRows, artRows, flatRows;
+        long long bulkBSTRows, bulkRBTRows, buildBPlusRows, buildARTRows, buildFlatRows;
+        long long loopBST, batchBST, loopRBT, batchRBT, loopBPlus, loopART, loopHash, batchHash, loopFlat, batchFlat, loopMM, batchMM;
+        {
+            ScopedCpuPin pin(cfg.pinCpu);
+            buildBST  = measureNs([&] { for (const auto& o : data) bst.insert(o); });
+            buildRBT  = measureNs([&] { for (const auto& o : data) rbt.insert(o); });
+            buildBPlus = measureNs([&] { for (const auto& o : data) bplus.insert(o); });
+            buildART  = measureNs([&] { for (const auto& o : data) art.insert(o); });
+            buildStatic = measureNs([&] { staticIndex.emplace(data); });
+            buildTable = measureNs([&] { table = ObjectTable(data); });
+            buildBloom = measureNs([&] {
+                bloom.emplace(staticIndex->keyCount());
+                bloom->buildFrom(data);
+            });
+            buildHash = measureNs([&] { for (const auto& o : data) hashTable.insert(o); });
+            buildFlat = measureNs([&] { for (const auto& o : data) flatHash.insert(o); });
+            buildMM   = measureNs([&] { for (const auto& o : data) mmap.insert({o.name, o}); });
+            {
+                // Пакетное построение: одна сортировка и построение за линейное время.
+                BinarySearchTree bulkTree;
+                RedBlackTree     bulkRbt;
+                bulkBST = measureNs([&] { bulkTree.buildFrom(data); });
+                bulkRBT = measureNs([&] { bulkRbt.buildFrom(data); });
+            }
+            BinarySearchTree<uint32_t>  bstByRow;
+            RedBlackTree<uint32_t>      rbtByRow;
+            BPlusTree<uint32_t>         bplusByRow;
+            AdaptiveRadixTree<uint32_t> artByRow;
+            FlatHashTable<uint32_t>     flatByRow(workload.cardinality());
+            bulkBSTRows    = measureNs([&] { bstByRow.buildFrom(table); });
+            bulkRBTRows    = measureNs([&] { rbtByRow.buildFrom(table); });
+            buildBPlusRows = measureNs([&] { insertRows(bplusByRow, table); });
+            buildARTRows   = measureNs([&] { insertRows(artByRow, table); });
+            buildFlatRows  = measureNs([&] { insertRows(flatByRow, table); });
+
+            auto run = [&](size_t cnt, size_t warm, auto&& op) {
+                return benchmarkLookups(searchKeys, cnt, warm, overhead, op);
+            };
+            lin      = run(linLookups, linWarmup, [&](const NameKey& k) { matched += linearSearch(data, k).size(); });
+            linView  = run(linLookups, linWarmup, [&](const NameKey& k) { linearSearchEach(data, k, count); });
+            linSoA   = run(linLookups, linWarmup, [&](const NameKey& k) {
+                linearSearchRows(table, k, [&matched](size_t) { ++matched; });
+            });
+            linSimd  = run(linLookups, linWarmup, [&](const NameKey& k) {
+                linearSearchSimd(table, k, [&matched](size_t) { ++matched; });
+            });
+            bstSt    = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += bst.search(k).size(); });
+            bstView  = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += bst.find(k).size(); });
+            rbtSt    = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += rbt.search(k).size(); });
+            rbtView  = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += rbt.find(k).size(); });
+            bplusSt  = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += bplus.search(k).size(); });
+            bplusView = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += bplus.find(k).size(); });
+            artSt    = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += art.search(k).size(); });
+            artView  = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += art.find(k).size(); });
+            staticSt = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += staticIndex->find(k).size(); });
+            hashSt   = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += hashTable.search(k).size(); });
+            hashView = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { hashTable.searchEach(k, count); });
+            flatSt   = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += flatHash.search(k).size(); });
+            flatView = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += flatHash.find(k).size(); });
+            mmSt     = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += multimapSearch(mmap, k).size(); });
+            mmView   = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { multimapSearchEach(mmap, k, count); });
+            bstRows   = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += bstByRow.find(k).size(); });
+            rbtRows   = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += rbtByRow.find(k).size(); });
+            bplusRows = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += bplusByRow.find(k).size(); });
+            artRows   = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += artByRow.find(k).size(); });
+            flatRows  = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) { matched += flatByRow.find(k).size(); });
+
+            // Те же поиски за фильтром Блума (сравнивать с LinearView, RBTView, HashView).
+            linBloom  = run(linLookups, linWarmup, [&](const NameKey& k) {
+                bloomGuarded(*bloom, k, [&](const NameKey& key) { return linearSearchEach(data, key, count); });
+            });
+            rbtBloom  = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) {
+                matched += bloomGuarded(*bloom, k, [&](const NameKey& key) { return rbt.find(key).size(); });
+            });
+            hashBloom = run(cfg.lookups, cfg.warmup, [&](const NameKey& k) {
+                bloomGuarded(*bloom, k, [&](const NameKey& key) { return hashTable.searchEach(key, count); });
+            });
+
+            // Пропускная способность (поисков в секунду): поиск по одному ключу и пакетный.
+            auto perSecond = [&searchKeys](long long ns) {
+                return static_cast<long long>(static_cast<double>(searchKeys.size()) * 1e9 /
+                                              static_cast<double>(std::max(ns, 1LL)));
+            };
+            auto countMany = [&matched](size_t, const Object&) { ++matched; };
+            const std::span<const NameKey> batch(searchKeys);
+            loopBST   = perSecond(measureNs([&] { for (const auto& k : searchKeys) matched += bst.find(k).size(); }));
+            batchBST  = perSecond(measureNs([&] { bst.searchMany(batch, countMany); }));
+            loopRBT   = perSecond(measureNs([&] { for (const auto& k : searchKeys) matched += rbt.find(k).size(); }));
+            batchRBT  = perSecond(measureNs([&] { rbt.searchMany(batch, countMany); }));
+            loopBPlus = perSecond(measureNs([&] { for (const auto& k : searchKeys) matched += bplus.find(k).size(); }));
+            loopART   = perSecond(measureNs([&] { for (const auto& k : searchKeys) matched += art.find(k).size(); }));
+            loopHash  = perSecond(measureNs([&] { for (const auto& k : searchKeys) hashTable.searchEach(k, count); }));
+            batchHash = perSecond(measureNs([&] { hashTable.searchMany(batch, countMany); }));
+            loopFlat  = perSecond(measureNs([&] { for (const auto& k : searchKeys) matched += flatHash.find(k).size(); }));
+            batchFlat = perSecond(measureNs([&] { flatHash.searchMany(batch, countMany); }));
+            loopMM    = perSecond(measureNs([&] { for (const auto& k : searchKeys) multimapSearchEach(mmap, k, count); }));
+            batchMM   = perSecond(measureNs([&] { multimapSearchMany(mmap, batch, countMany); }));
+
+            destroyBST = measureNs([&] { bst.clear(); });
+            destroyRBT = measureNs([&] { rbt.clear(); });
+        }
+
+        // Кривые масштабирования параллельного линейного поиска и параллельного
+        // построения HashTable: 1..cfg.threads потоков.
+        double parallelBase = 0, buildBase = 0;
+        for (size_t t = 1; t <= cfg.threads; ++t) {
+            ThreadPool pool(t);
+            LatencyStats par = benchmarkLookups(searchKeys, linLookups, linWarmup, overhead,
+                    [&](const NameKey& k) { matched += parallelLinearSearch(data, k, pool).size(); });
+            if (t == 1) parallelBase = par.mean;
+            long long hashBuild;
+            {
+                HashTable<> parallelTable;
+                hashBuild = measureNs([&] { parallelTable.buildFrom(data, pool); });
+            }
+            if (t == 1) buildBase = static_cast<double>(hashBuild);
+            scalingFile.add("Size", n)
+                       .add("Threads", t)
+                       .add("LinearParallel", static_cast<long long>(par.mean))
+                       .add("LinearParallel_p50", par.p50)
+                       .add("Speedup", parallelBase / std::max(par.mean, 1.0))
+                       .add("HashBuild", hashBuild)
+                       .add("HashBuildSpeedup", buildBase / static_cast<double>(std::max(hashBuild, 1LL)));
+            scalingFile.endRow();
+        }
+
+        volatile size_t sink = matched;
+        (void)sink;
+
+        auto mean = [](const LatencyStats& st) { return static_cast<long long>(st.mean); };
+        // Доля ложноположительных ответов фильтра на заведомо отсутствующих ключах.
+        const size_t fprProbes = 100000;
+        size_t falsePositives = 0;
+        for (size_t i = 0; i < fprProbes; ++i) {
+            falsePositives += bloom->mayContain(workload.absentKey(i));
+        }
+        // Пропускная способность полного скана (ГБ/с = байт/нс): AoS протаскивает
+        // через кэш объекты целиком, SoA и SIMD читают только столбец хешей.
+        auto scanGBps = [n](size_t bytesPerRow, const LatencyStats& st) {
+            return static_cast<double>(n * bytesPerRow) / std::max(st.mean, 1.0);
+        };
+        // Память индекса на ключ без содержимого строк и массивов объектов.
+        const double artBytesPerKey = static_cast<double>(art.memoryBytes()) /
+                                      static_cast<double>(std::max<size_t>(art.keyCount(), 1));
+        resultFile.add("Size", n)
+                  .add("Linear", mean(lin))
+                  .add("BST", mean(bstSt))
+                  .add("RBT", mean(rbtSt))
+                  .add("BPlus", mean(bplusSt))
+                  .add("ART", mean(artSt))
+                  .add("StaticIndex", mean(staticSt))
+                  .add("Hash", mean(hashSt))
+                  .add("FlatHash", mean(flatSt))
+                  .add("Multimap", mean(mmSt))
+                  .add("Collisions", hashTable.getCollisionCount())
+                  .add("Popularity", popularityName(cfg.workload.popularity))
+                  .add("MissRatio", cfg.workload.missRatio)
+                  .add("Cardinality", workload.cardinality())
+                  .add("AvgKeyLength", workload.averageKeyLength())
+                  .add("LinearView", mean(linView))
+                  .add("BSTView", mean(bstView))
+                  .add("RBTView", mean(rbtView))
+                  .add("BPlusView", mean(bplusView))
+                  .add("ARTView", mean(artView))
+                  .add("HashView", mean(hashView))
+                  .add("FlatHashView", mean(flatView))
+                  .add("MultimapView", mean(mmView))
+                  .add("BST_Rows", mean(bstRows))
+                  .add("RBT_Rows", mean(rbtRows))
+                  .add("BPlus_Rows", mean(bplusRows))
+                  .add("ART_Rows", mean(artRows))
+                  .add("FlatHash_Rows", mean(flatRows))
+                  .add("LinearSoA", mean(linSoA))
+                  .add("LinearSIMD", mean(linSimd))
+                  .add("Linear_Bloom", mean(linBloom))
+                  .add("RBT_Bloom", mean(rbtBloom))
+                  .add("Hash_Bloom", mean(hashBloom))
+                  .add("ScanGBps_AoS", scanGBps(sizeof(Object), linView))
+                  .add("ScanGBps_SoA", scanGBps(sizeof(uint64_t), linSoA))
+                  .add("ScanGBps_SIMD", scanGBps(sizeof(uint64_t), linSimd))
+                  .add("Build_BST", buildBST)
+                  .add("Build_RBT", buildRBT)
+                  .add("Build_BPlus", buildBPlus)
+                  .add("Build_ART", buildART)
+                  .add("Build_StaticIndex", buildStatic)
+                  .add("Build_Hash", buildHash)
+                  .add("Build_FlatHash", buildFlat)
+                  .add("Build_Multimap", buildMM)
+                  .add("Build_ObjectTable", buildTable)
+                  .add("Build_Bloom", buildBloom)
+                  .add("BulkBuild_BST", bulkBST)
+                  .add("BulkBuild_RBT", bulkRBT)
+                  .add("BulkBuild_BST_Rows", bulkBSTRows)
+                  .add("BulkBuild_RBT_Rows", bulkRBTRows)
+                  .add("Build_BPlus_Rows", buildBPlusRows)
+                  .add("Build_ART_Rows", buildARTRows)
+                  .add("Build_FlatHash_Rows", buildFlatRows)
+                  .add("Destroy_BST", destroyBST)
+                  .add("Destroy_RBT", destroyRBT)
+                  .add("Lps_BST", loopBST)
+                  .add("Lps_RBT", loopRBT)
+                  .add("Lps_BPlus", loopBPlus)
+                  .add("Lps_ART", loopART)
+                  .add("Lps_Hash", loopHash)
+                  .add("Lps_FlatHash", loopFlat)
+                  .add("Lps_Multimap", loopMM)
+                  .add("BatchLps_BST", batchBST)
+                  .add("BatchLps_RBT", batchRBT)
+                  .add("BatchLps_Hash", batchHash)
+                  .add("BatchLps_FlatHash", batchFlat)
+                  .add("BatchLps_Multimap", batchMM)
+                  .addStats("Linear", lin)
+                  .addStats("BST", bstSt)
+                  .addStats("RBT", rbtSt)
+                  .addStats("BPlus", bplusSt)
+                  .addStats("ART", artSt)
+                  .addStats("StaticIndex", staticSt)
+                  .addStats("Hash", hashSt)
+                  .addStats("FlatHash", flatSt)
+                  .addStats("Multimap", mmSt)
+                  .addStats("LinearView", linView)
+                  .addStats("LinearSoA", linSoA)
+                  .addStats("LinearSIMD", linSimd)
+                  .addStats("Linear_Bloom", linBloom)
+                  .addStats("RBT_Bloom", rbtBloom)
+                  .addStats("Hash_Bloom", hashBloom)
+                  .add("Bloom_FPR", static_cast<double>(falsePositives) / static_cast<double>(fprProbes))
+                  .add("Bloom_BitsPerKey", static_cast<double>(bloom->memoryBytes() * 8) /
+                                           static_cast<double>(std::max<size_t>(staticIndex->keyCount(), 1)))
+                  .addStats("BSTView", bstView)
+                  .addStats("RBTView", rbtView)
+                  .addStats("BPlusView", bplusView)
+                  .addStats("ARTView", artView)
+                  .addStats("HashView", hashView)
+                  .addStats("FlatHashView", flatView)
+                  .addStats("MultimapView", mmView)
+                  .add("ART_BytesPerKey", static_cast<long long>(artBytesPerKey))
+                  .add("RBT_BytesPerKey", sizeof(RedBlackTree<>::Node));
+        resultFile.endRow();
 
         std::cout << "n=" << n
-                  << " Lin=" << avgLin
-                  << " BST=" << avgBST
-                  << " RBT=" << avgRBT
-                  << " Hash=" << avgHash
-                  << " MM=" << avgMM
-                  << " coll=" << collisions
+                  << " Lin=" << mean(lin)
+                  << " LinSoA=" << mean(linSoA)
+                  << " LinSIMD=" << mean(linSimd)
+                  << " BST=" << mean(bstSt)
+                  << " RBT=" << mean(rbtSt)
+                  << " B+=" << mean(bplusSt)
+                  << " ART=" << mean(artSt)
+                  << " Static=" << mean(staticSt)
+                  << " Hash=" << mean(hashSt)
+                  << " Flat=" << mean(flatSt)
+                  << " MM=" << mean(mmSt)
+                  << " coll=" << hashTable.getCollisionCount()
+                  << " | p99: BST=" << bstSt.p99
+                  << " RBT=" << rbtSt.p99
+                  << " B+=" << bplusSt.p99
+                  << " ART=" << artSt.p99
+                  << " Static=" << staticSt.p99
+                  << " Hash=" << hashSt.p99
+                  << " Flat=" << flatSt.p99
+                  << " MM=" << mmSt.p99
+                  << " | build: BST=" << buildBST << " RBT=" << buildRBT << " B+=" << buildBPlus << " ART=" << buildART << " Static=" << buildStatic
+                  << " Hash=" << buildHash << " Flat=" << buildFlat << " MM=" << buildMM
+                  << " bulk BST=" << bulkBST << " RBT=" << bulkRBT
+                  << " | destroy: BST=" << destroyBST << " RBT=" << destroyRBT
+                  << " | lookups/s loop->batch: BST=" << loopBST << "->" << batchBST
+                  << " RBT=" << loopRBT << "->" << batchRBT
+                  << " B+=" << loopBPlus
+                  << " ART=" << loopART
+                  << " Hash=" << loopHash << "->" << batchHash
+                  << " Flat=" << loopFlat << "->" << batchFlat
+                  << " MM=" << loopMM << "->" << batchMM
+                  << " | ART " << static_cast<long long>(artBytesPerKey) << " Б/ключ"
                   << "\n";
     }
 
+}
+
+int main(int argc, char* argv[]) {
+    const BenchmarkConfig cfg = parseArgs(argc, argv);
+    setlocale(LC_ALL, "ru_RU.UTF-8");
+#ifdef _WIN32
+    SetConsoleCP(65001);
+    SetConsoleOutputCP(65001);
+#endif
+    rng.seed(cfg.seed);
+    const long long overhead = timerOverheadNs();
+    std::cout << "Накладные расходы таймера: " << overhead << " нс\n"
+              << "Зерно: " << cfg.seed << " (повтор: --seed " << cfg.seed << ")\n"
+              << "Ядро векторного скана: " << nameScanKernel().name << "\n";
+
+    if (cfg.mode == "search") {
+        runSearchBenchmark(cfg, overhead);
+    } else if (cfg.mode == "hash") {
+        runHashBenchmark(cfg, overhead);
+    } else if (cfg.mode == "growth") {
+        runGrowthBenchmark(cfg, overhead);
+    } else if (cfg.mode == "concurrent") {
+        runConcurrentBenchmark(cfg);
+    } else if (cfg.mode == "snapshot") {
+        runSnapshotBenchmark(cfg);
+    } else if (cfg.mode == "churn") {
+        runChurnBenchmark(cfg, overhead);
+    } else if (cfg.mode == "range") {
+        runRangeBenchmark(cfg);
+    } else if (cfg.mode == "workload") {
+        runWorkloadBenchmark(cfg, overhead);
+    } else {
+        std::cerr << "Неизвестный режим: " << cfg.mode << "\n";
+        return 1;
+    }
     return 0;
 }